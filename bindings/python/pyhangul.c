@@ -136,6 +136,47 @@ static PyObject *_pyhangulic_process(PY_HANGULIC *self, PyObject *args)
     return Py_BuildValue("i", ret);
 }
 
+static PyObject *_ucschar_to_unicode(const ucschar *str, int len)
+{
+#ifdef Py_UNICODE_WIDE
+    return PyUnicode_FromUnicode((Py_UNICODE*)str, len);
+#else  /* Py_UNICODE_WIDE */
+    int i;
+    Py_UNICODE *buf;
+
+    buf = alloca(sizeof(Py_UNICODE) * len);
+    for (i = 0; i < len; i++)
+	buf[i] = str[i];
+    return PyUnicode_FromUnicode(buf, len);
+#endif /* Py_UNICODE_WIDE */
+}
+
+/* returns (ret, commit_string, preedit_string, flags) in one call */
+static PyObject *_pyhangulic_process_ex(PY_HANGULIC *self, PyObject *args)
+{
+    int ret;
+    int ascii;
+    HangulICResult result;
+    PyObject *commit;
+    PyObject *preedit;
+    PyObject *tuple;
+
+    if(!PyArg_ParseTuple(args,"i", &ascii)) {
+	PyErr_SetString(_pyhangul_error,"Usage: process_ex(ascii)");
+	return NULL;
+    }
+
+    ret = hangul_ic_process_ex(self->hic, ascii, &result);
+
+    commit = _ucschar_to_unicode(result.commit, result.commit_len);
+    preedit = _ucschar_to_unicode(result.preedit, result.preedit_len);
+    tuple = Py_BuildValue("(iOOI)", ret, commit, preedit, result.flags);
+    Py_XDECREF(commit);
+    Py_XDECREF(preedit);
+
+    return tuple;
+}
+
 static PyObject *_pyhangulic_reset(PY_HANGULIC *self, PyObject *args)
 {
     hangul_ic_reset(self->hic);
@@ -221,6 +262,7 @@ static PyObject *_pyhangulic_commit_string(PY_HANGULIC *self, PyObject *args)
 /* PY_HANGULIC methods */
 static PyMethodDef PY_HANGULIC_methods[] = {
     { "process",       (PyCFunction)_pyhangulic_process,        METH_VARARGS, NULL},
+    { "process_ex",    (PyCFunction)_pyhangulic_process_ex,     METH_VARARGS, NULL},
     { "reset",         (PyCFunction)_pyhangulic_reset,          METH_VARARGS, NULL},
     { "flush",         (PyCFunction)_pyhangulic_flush,          METH_VARARGS, NULL},
     { "backspace",     (PyCFunction)_pyhangulic_backspace,      METH_VARARGS, NULL},
@@ -24,5 +24,17 @@ class TestHangul(unittest.TestCase):
         buffer += self.ic.commit_string()
         self.assertEqual(output, buffer)
 
+    def testProcessEx(self):
+        input  = u"vkdlTjs gksrmf"
+        output = u"파이썬 한글"
+        buffer = u''
+        for i in input:
+            ret, commit, preedit, flags = self.ic.process_ex(ord(i))
+            buffer += commit
+            if not ret:
+                buffer += str(i)
+        buffer += self.ic.flush()
+        self.assertEqual(output, buffer)
+
 if __name__ == '__main__':
     unittest.main()
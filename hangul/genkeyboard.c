@@ -0,0 +1,846 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+
+/* 내장 자판 테이블 생성 프로그램
+ *
+ * data/keyboards 의 자판 XML 파일을 읽어서 hangulkeyboard.c 에서 include 하는
+ * hangulkeyboard.h 를 만든다. 내장 자판과 외부 자판 파일이 같은 데이터를
+ * 사용하도록 빌드할 때마다 이 프로그램으로 헤더를 새로 생성한다.
+ *
+ * 사용법: genkeyboard OUTPUT KEYBOARD_XML...
+ *
+ * 명령행에 준 순서대로 hangul_builtin_keyboards[] 에 등록된다.
+ * id로 자판을 찾을 수 있도록 hangul_builtin_keyboard_index[] 에 id의
+ * 해시 테이블도 만든다.
+ * 여러 자판에서 include 하는 조합 파일은 테이블을 하나만 만들어 공유한다.
+ * 조합 테이블은 hangulkeyboard.c 에서 찾을 때 사용하는 perfect hash도 같이
+ * 만든다.
+ * libhangul 에 의존하지 않아야 라이브러리보다 먼저 빌드할 수 있으므로
+ * expat 대신 자판 파일에 쓰이는 만큼의 XML 만 직접 파싱한다. */
+
+#define KEYBOARD_TABLE_SIZE 0x80
+#define KEYBOARD_MAX_MAPS   4
+#define MAX_KEYBOARDS	    64
+#define MAX_COMBINATIONS    64
+#define MAX_ATTRS	    8
+#define MAX_INCLUDE_DEPTH   16
+
+typedef struct {
+    char name[64];
+    char value[256];
+} Attr;
+
+typedef struct {
+    unsigned int key;
+    unsigned int code;
+} CombinationItem;
+
+typedef struct {
+    char source[1024];
+    char name[64];
+    CombinationItem* items;
+    size_t n;
+    size_t nalloced;
+} Combination;
+
+typedef struct {
+    char id[64];
+    char ident[64];
+    char name[256];
+    const char* type;
+    unsigned int table[KEYBOARD_MAX_MAPS][KEYBOARD_TABLE_SIZE];
+    bool has_table[KEYBOARD_MAX_MAPS];
+    int combination[KEYBOARD_MAX_MAPS];
+} Keyboard;
+
+typedef struct {
+    Keyboard* keyboard;
+    const char* path;
+    enum { ELEMENT_NONE, ELEMENT_MAP, ELEMENT_COMBINATION } element;
+    unsigned int id;
+    Combination* combination;
+    int depth;
+} ParseContext;
+
+static const char* program_name = "genkeyboard";
+
+static Keyboard keyboards[MAX_KEYBOARDS];
+static int n_keyboards = 0;
+static Combination combinations[MAX_COMBINATIONS];
+static int n_combinations = 0;
+
+static void
+die(const char* path, const char* msg, const char* arg)
+{
+    fprintf(stderr, "%s: %s: %s%s%s\n", program_name, path, msg,
+	    arg != NULL ? ": " : "", arg != NULL ? arg : "");
+    exit(EXIT_FAILURE);
+}
+
+static char*
+read_file(const char* path)
+{
+    FILE* file;
+    char* buf = NULL;
+    size_t len = 0;
+    size_t alloced = 0;
+    size_t n;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+	die(path, "cannot open file", NULL);
+
+    do {
+	if (alloced - len < 4096) {
+	    alloced = alloced == 0 ? 16384 : alloced * 2;
+	    buf = realloc(buf, alloced);
+	    if (buf == NULL)
+		die(path, "out of memory", NULL);
+	}
+	n = fread(buf + len, 1, alloced - len - 1, file);
+	len += n;
+    } while (n > 0);
+
+    fclose(file);
+    buf[len] = '\0';
+    return buf;
+}
+
+static const char*
+attr_lookup(const Attr* attrs, int n, const char* name)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+	if (strcmp(attrs[i].name, name) == 0)
+	    return attrs[i].value;
+    }
+    return NULL;
+}
+
+static unsigned int
+attr_lookup_as_uint(const ParseContext* context,
+		    const Attr* attrs, int n, const char* name)
+{
+    const char* str = attr_lookup(attrs, n, name);
+    char* end;
+    unsigned long value;
+
+    if (str == NULL)
+	die(context->path, "missing attribute", name);
+
+    value = strtoul(str, &end, 0);
+    if (end == str || *end != '\0')
+	die(context->path, "invalid number", str);
+
+    return value;
+}
+
+/* 파일 이름에서 디렉토리, 확장자, 공통 접두어를 떼고 C 식별자로 쓸 수 있는
+ * 문자만 남긴다. */
+static void
+make_ident(char* dest, size_t size, const char* str, const char* prefix)
+{
+    const char* p = strrchr(str, '/');
+    size_t i = 0;
+
+    if (p != NULL)
+	str = p + 1;
+    if (prefix != NULL && strncmp(str, prefix, strlen(prefix)) == 0)
+	str += strlen(prefix);
+
+    for (p = str; *p != '\0' && *p != '.' && i + 1 < size; p++) {
+	dest[i++] = isalnum((unsigned char)*p) ? *p : '_';
+    }
+    dest[i] = '\0';
+}
+
+static const char*
+keyboard_type_from_string(const ParseContext* context, const char* type)
+{
+    if (type == NULL || strcmp(type, "jamo") == 0)
+	return "HANGUL_KEYBOARD_TYPE_JAMO";
+    if (strcmp(type, "jamo-yet") == 0)
+	return "HANGUL_KEYBOARD_TYPE_JAMO_YET";
+    if (strcmp(type, "jaso") == 0)
+	return "HANGUL_KEYBOARD_TYPE_JASO";
+    if (strcmp(type, "jaso-yet") == 0)
+	return "HANGUL_KEYBOARD_TYPE_JASO_YET";
+    if (strcmp(type, "romaja") == 0)
+	return "HANGUL_KEYBOARD_TYPE_ROMAJA";
+
+    die(context->path, "unknown keyboard type", type);
+    return NULL;
+}
+
+static void
+combination_add_item(Combination* combination,
+		     unsigned int first, unsigned int second, unsigned int result)
+{
+    if (combination->n >= combination->nalloced) {
+	size_t n = combination->nalloced == 0 ? 64 : combination->nalloced * 2;
+	CombinationItem* items = realloc(combination->items, n * sizeof(items[0]));
+	if (items == NULL)
+	    die(combination->source, "out of memory", NULL);
+	combination->items = items;
+	combination->nalloced = n;
+    }
+
+    combination->items[combination->n].key = first << 16 | second;
+    combination->items[combination->n].code = result;
+    combination->n++;
+}
+
+static int
+combination_item_cmp(const void* p1, const void* p2)
+{
+    const CombinationItem* item1 = p1;
+    const CombinationItem* item2 = p2;
+
+    if (item1->key < item2->key)
+	return -1;
+    else if (item1->key > item2->key)
+	return 1;
+    return 0;
+}
+
+static void
+combination_sort(Combination* combination)
+{
+    size_t i;
+
+    qsort(combination->items, combination->n, sizeof(combination->items[0]),
+	  combination_item_cmp);
+
+    /* 같은 키가 두번 나오면 어느 쪽을 사용할지 알 수 없다. */
+    for (i = 1; i < combination->n; i++) {
+	if (combination->items[i - 1].key == combination->items[i].key)
+	    die(combination->source, "duplicated combination item", NULL);
+    }
+}
+
+/* hangulkeyboard.c 의 hangul_combination_hash() 와 같아야 한다. */
+static unsigned int
+combination_hash(unsigned int key, unsigned int seed)
+{
+    unsigned int h = ((key ^ seed) * 0x9e3779b1u) & 0xffffffffu;
+    h ^= h >> 16;
+    h = (h * 0x85ebca6bu) & 0xffffffffu;
+    h ^= h >> 13;
+    return h;
+}
+
+/* hangulkeyboard.c 의 hangul_combination_build_hash() 와 같은 방법으로
+ * perfect hash를 만든다. 키가 많은 bucket 부터 다른 키와 겹치지 않는
+ * displacement 를 찾는다. */
+static bool
+combination_try_hash(const Combination* combination, unsigned int seed,
+		     unsigned int bucket_bits, size_t nslots,
+		     CombinationItem* slots, unsigned int* disp)
+{
+    size_t nbuckets = (size_t)1 << bucket_bits;
+    size_t n = combination->n;
+    unsigned int* hashes = malloc(n * sizeof(hashes[0]));
+    unsigned int* buckets = malloc(n * sizeof(buckets[0]));
+    size_t* sizes = calloc(nbuckets, sizeof(sizes[0]));
+    bool* used = calloc(nslots, sizeof(used[0]));
+    size_t max_size = 0;
+    size_t i, j, b, size, d;
+    bool res = true;
+
+    if (hashes == NULL || buckets == NULL || sizes == NULL || used == NULL)
+	die(combination->source, "out of memory", NULL);
+
+    memset(slots, 0, nslots * sizeof(slots[0]));
+    memset(disp, 0, nbuckets * sizeof(disp[0]));
+    for (i = 0; i < n; i++) {
+	hashes[i] = combination_hash(combination->items[i].key, seed);
+	buckets[i] = hashes[i] >> (32 - bucket_bits);
+	if (++sizes[buckets[i]] > max_size)
+	    max_size = sizes[buckets[i]];
+    }
+
+    for (size = max_size; res && size > 0; size--) {
+	for (b = 0; res && b < nbuckets; b++) {
+	    if (sizes[b] != size)
+		continue;
+
+	    for (d = 0; d < nslots; d++) {
+		for (i = 0; i < n; i++) {
+		    if (buckets[i] != b)
+			continue;
+		    if (used[(hashes[i] + d) & (nslots - 1)])
+			break;
+		    used[(hashes[i] + d) & (nslots - 1)] = true;
+		}
+		if (i == n)
+		    break;
+		for (j = 0; j < i; j++) {
+		    if (buckets[j] == b)
+			used[(hashes[j] + d) & (nslots - 1)] = false;
+		}
+	    }
+
+	    if (d == nslots) {
+		res = false;
+		break;
+	    }
+
+	    disp[b] = d;
+	    for (i = 0; i < n; i++) {
+		if (buckets[i] == b)
+		    slots[(hashes[i] + d) & (nslots - 1)] = combination->items[i];
+	    }
+	}
+    }
+
+    free(hashes);
+    free(buckets);
+    free(sizes);
+    free(used);
+    return res;
+}
+
+static void
+write_combination_hash(FILE* out, const Combination* combination)
+{
+    size_t n = combination->n;
+    size_t nslots = 2;
+    size_t nbuckets = 2;
+    unsigned int bucket_bits = 1;
+    CombinationItem* slots = NULL;
+    unsigned int* disp = NULL;
+    unsigned int seed = 0;
+    unsigned int i;
+    size_t j;
+
+    while (nslots < n + n / 4)
+	nslots *= 2;
+    while (nbuckets < n / 4 && bucket_bits < 31) {
+	nbuckets *= 2;
+	bucket_bits++;
+    }
+
+    for (;;) {
+	slots = realloc(slots, nslots * sizeof(slots[0]));
+	disp = realloc(disp, nbuckets * sizeof(disp[0]));
+	if (slots == NULL || disp == NULL)
+	    die(combination->source, "out of memory", NULL);
+
+	for (i = 0; i < 64; i++) {
+	    seed = (i * 0x9e3779b9u) & 0xffffffffu;
+	    if (combination_try_hash(combination, seed, bucket_bits, nslots,
+				     slots, disp))
+		break;
+	}
+	if (i < 64)
+	    break;
+	nslots *= 2;
+    }
+
+    fprintf(out, "\nstatic const uint32_t hangul_combination_disp_%s[%zu] = {",
+	    combination->name, nbuckets);
+    for (j = 0; j < nbuckets; j++)
+	fprintf(out, "%s%u,", j % 8 == 0 ? "\n   " : "", disp[j]);
+    fprintf(out, "\n};\n");
+
+    fprintf(out, "\nstatic const HangulCombinationItem hangul_combination_hash_%s[%zu] = {\n",
+	    combination->name, nslots);
+    for (j = 0; j < nslots; j++) {
+	fprintf(out, "    { 0x%08x, 0x%04x },\n", slots[j].key, slots[j].code);
+    }
+    fprintf(out, "};\n");
+
+    fprintf(out, "\nstatic const HangulCombination hangul_combination_builtin_%s = {\n"
+	    "    countof(hangul_combination_table_%s),\n"
+	    "    countof(hangul_combination_table_%s),\n"
+	    "    (HangulCombinationItem*)hangul_combination_table_%s,\n"
+	    "    true,\n"
+	    "    0x%08x, %u, 0x%zx,\n"
+	    "    hangul_combination_disp_%s,\n"
+	    "    hangul_combination_hash_%s\n"
+	    "};\n",
+	    combination->name, combination->name,
+	    combination->name, combination->name,
+	    seed, 32 - bucket_bits, nslots - 1,
+	    combination->name, combination->name);
+
+    free(slots);
+    free(disp);
+}
+
+/* 같은 파일의 같은 combination 은 여러 자판이 include 해도 한번만 만든다.
+ * 이미 만든 것이면 NULL 을 리턴하고 *index 에 그 위치를 알려준다. */
+static Combination*
+combination_find_or_new(const ParseContext* context, unsigned int id, int* index)
+{
+    Combination* combination;
+    char source[1024];
+    int i;
+
+    snprintf(source, sizeof(source), "%s#%u", context->path, id);
+    for (i = 0; i < n_combinations; i++) {
+	if (strcmp(combinations[i].source, source) == 0) {
+	    *index = i;
+	    return NULL;
+	}
+    }
+
+    if (n_combinations >= MAX_COMBINATIONS)
+	die(context->path, "too many combinations", NULL);
+
+    combination = &combinations[n_combinations];
+    strcpy(combination->source, source);
+    if (context->depth > 0) {
+	/* include 한 파일의 combination 은 파일 이름을 따서 이름을 짓고
+	 * 자판 파일 안에 있는 것은 자판 id를 이름으로 쓴다. */
+	make_ident(combination->name, sizeof(combination->name) - 16,
+		   context->path, "hangul-combination-");
+    } else {
+	strcpy(combination->name, context->keyboard->ident);
+    }
+    if (id != 0)
+	sprintf(combination->name + strlen(combination->name), "_%u", id);
+
+    for (i = 0; i < n_combinations; i++) {
+	if (strcmp(combinations[i].name, combination->name) == 0)
+	    die(context->path, "duplicated combination name", combination->name);
+    }
+
+    *index = n_combinations++;
+    return combination;
+}
+
+static void parse_file(ParseContext* context, const char* path);
+
+static void
+on_element_start(ParseContext* context, const char* element,
+		 const Attr* attrs, int nattrs, const char* text)
+{
+    Keyboard* keyboard = context->keyboard;
+
+    if (strcmp(element, "hangul-keyboard") == 0) {
+	const char* id = attr_lookup(attrs, nattrs, "id");
+	if (id == NULL || id[0] == '\0')
+	    die(context->path, "keyboard without id", NULL);
+	if (strlen(id) >= sizeof(keyboard->id))
+	    die(context->path, "keyboard id is too long", id);
+
+	strcpy(keyboard->id, id);
+	make_ident(keyboard->ident, sizeof(keyboard->ident), id, NULL);
+	keyboard->type = keyboard_type_from_string(context,
+					attr_lookup(attrs, nattrs, "type"));
+    } else if (strcmp(element, "name") == 0) {
+	/* 번역된 이름은 gettext 로 처리하므로 기본 이름만 사용한다. */
+	size_t len;
+
+	if (attr_lookup(attrs, nattrs, "xml:lang") != NULL)
+	    return;
+	if (keyboard->name[0] != '\0')
+	    return;
+
+	while (isspace((unsigned char)*text))
+	    text++;
+	len = strcspn(text, "<");
+	while (len > 0 && isspace((unsigned char)text[len - 1]))
+	    len--;
+	if (len >= sizeof(keyboard->name))
+	    die(context->path, "keyboard name is too long", NULL);
+
+	memcpy(keyboard->name, text, len);
+	keyboard->name[len] = '\0';
+    } else if (strcmp(element, "map") == 0) {
+	unsigned int id = attr_lookup_as_uint(context, attrs, nattrs, "id");
+	if (id >= KEYBOARD_MAX_MAPS)
+	    die(context->path, "invalid map id", attr_lookup(attrs, nattrs, "id"));
+
+	context->element = ELEMENT_MAP;
+	context->id = id;
+	keyboard->has_table[id] = true;
+    } else if (strcmp(element, "combination") == 0) {
+	unsigned int id = attr_lookup_as_uint(context, attrs, nattrs, "id");
+	if (id >= KEYBOARD_MAX_MAPS)
+	    die(context->path, "invalid combination id",
+		attr_lookup(attrs, nattrs, "id"));
+
+	context->element = ELEMENT_COMBINATION;
+	context->id = id;
+	context->combination = combination_find_or_new(context, id,
+					    &keyboard->combination[id]);
+    } else if (strcmp(element, "item") == 0) {
+	if (context->element == ELEMENT_MAP) {
+	    unsigned int key = attr_lookup_as_uint(context, attrs, nattrs, "key");
+	    unsigned int value = attr_lookup_as_uint(context, attrs, nattrs, "value");
+	    if (key >= KEYBOARD_TABLE_SIZE)
+		die(context->path, "key is out of range",
+		    attr_lookup(attrs, nattrs, "key"));
+
+	    keyboard->table[context->id][key] = value;
+	} else if (context->element == ELEMENT_COMBINATION) {
+	    unsigned int first = attr_lookup_as_uint(context, attrs, nattrs, "first");
+	    unsigned int second = attr_lookup_as_uint(context, attrs, nattrs, "second");
+	    unsigned int result = attr_lookup_as_uint(context, attrs, nattrs, "result");
+
+	    if (context->combination != NULL)
+		combination_add_item(context->combination, first, second, result);
+	}
+    } else if (strcmp(element, "include") == 0) {
+	const char* file = attr_lookup(attrs, nattrs, "file");
+	const char* slash;
+	char path[1024];
+	ParseContext child;
+
+	if (file == NULL)
+	    die(context->path, "include without file", NULL);
+
+	slash = strrchr(context->path, '/');
+#ifdef _WIN32
+	/* 윈도우에서는 경로 구분자로 '\\' 도 쓴다. */
+	if (strrchr(context->path, '\\') != NULL &&
+	    (slash == NULL || strrchr(context->path, '\\') > slash))
+	    slash = strrchr(context->path, '\\');
+#endif
+	if (file[0] == '/' || slash == NULL) {
+	    snprintf(path, sizeof(path), "%s", file);
+	} else {
+	    snprintf(path, sizeof(path), "%.*s/%s",
+		     (int)(slash - context->path), context->path, file);
+	}
+
+	if (context->depth >= MAX_INCLUDE_DEPTH)
+	    die(context->path, "too deep include", file);
+
+	child = *context;
+	child.element = ELEMENT_NONE;
+	child.combination = NULL;
+	child.depth = context->depth + 1;
+	parse_file(&child, path);
+    }
+}
+
+static void
+on_element_end(ParseContext* context, const char* element)
+{
+    if (strcmp(element, "map") == 0) {
+	context->element = ELEMENT_NONE;
+    } else if (strcmp(element, "combination") == 0) {
+	if (context->combination != NULL)
+	    combination_sort(context->combination);
+	context->combination = NULL;
+	context->element = ELEMENT_NONE;
+    }
+}
+
+static const char*
+parse_name(const ParseContext* context, const char* p, char* buf, size_t size)
+{
+    size_t i = 0;
+
+    while (*p != '\0' && (isalnum((unsigned char)*p) ||
+			  *p == '-' || *p == '_' || *p == ':' || *p == '.')) {
+	if (i + 1 >= size)
+	    die(context->path, "name is too long", NULL);
+	buf[i++] = *p++;
+    }
+    buf[i] = '\0';
+
+    if (i == 0)
+	die(context->path, "syntax error", NULL);
+    return p;
+}
+
+/* 자판 파일에 쓰이는 만큼만 처리하는 간단한 XML 파서.
+ * 주석, <?...?> 처리 지시자, 속성, 빈 요소 태그를 지원한다. */
+static void
+parse_file(ParseContext* context, const char* path)
+{
+    char* buf = read_file(path);
+    const char* p = buf;
+    char element[64];
+    Attr attrs[MAX_ATTRS];
+    int nattrs;
+
+    context->path = path;
+
+    while ((p = strchr(p, '<')) != NULL) {
+	if (strncmp(p, "<!--", 4) == 0) {
+	    p = strstr(p + 4, "-->");
+	    if (p == NULL)
+		die(path, "unterminated comment", NULL);
+	    p += 3;
+	    continue;
+	}
+
+	if (p[1] == '?') {
+	    p = strstr(p + 2, "?>");
+	    if (p == NULL)
+		die(path, "unterminated processing instruction", NULL);
+	    p += 2;
+	    continue;
+	}
+
+	if (p[1] == '/') {
+	    p = parse_name(context, p + 2, element, sizeof(element));
+	    p = strchr(p, '>');
+	    if (p == NULL)
+		die(path, "unterminated tag", element);
+	    p++;
+	    on_element_end(context, element);
+	    continue;
+	}
+
+	p = parse_name(context, p + 1, element, sizeof(element));
+	nattrs = 0;
+	for (;;) {
+	    const char* end;
+	    char quote;
+
+	    while (isspace((unsigned char)*p))
+		p++;
+
+	    if (*p == '>' || (p[0] == '/' && p[1] == '>'))
+		break;
+	    if (*p == '\0')
+		die(path, "unterminated tag", element);
+	    if (nattrs >= MAX_ATTRS)
+		die(path, "too many attributes", element);
+
+	    p = parse_name(context, p, attrs[nattrs].name, sizeof(attrs[nattrs].name));
+	    while (isspace((unsigned char)*p))
+		p++;
+	    if (*p != '=')
+		die(path, "syntax error", attrs[nattrs].name);
+	    p++;
+	    while (isspace((unsigned char)*p))
+		p++;
+
+	    quote = *p;
+	    if (quote != '"' && quote != '\'')
+		die(path, "syntax error", attrs[nattrs].name);
+	    end = strchr(p + 1, quote);
+	    if (end == NULL || end - p - 1 >= (int)sizeof(attrs[nattrs].value))
+		die(path, "invalid attribute value", attrs[nattrs].name);
+
+	    memcpy(attrs[nattrs].value, p + 1, end - p - 1);
+	    attrs[nattrs].value[end - p - 1] = '\0';
+	    nattrs++;
+	    p = end + 1;
+	}
+
+	if (*p == '/') {
+	    p += 2;
+	    on_element_start(context, element, attrs, nattrs, p);
+	    on_element_end(context, element);
+	} else {
+	    p += 1;
+	    on_element_start(context, element, attrs, nattrs, p);
+	}
+    }
+
+    free(buf);
+}
+
+static void
+write_string(FILE* out, const char* str)
+{
+    fputc('"', out);
+    for (; *str != '\0'; str++) {
+	if (*str == '"' || *str == '\\')
+	    fputc('\\', out);
+	fputc(*str, out);
+    }
+    fputc('"', out);
+}
+
+/* hangulkeyboard.c 의 hangul_keyboard_id_hash() 와 같아야 한다. */
+static unsigned int
+keyboard_id_hash(const char* id)
+{
+    unsigned int h = 2166136261u;
+
+    while (*id != '\0') {
+	h ^= (unsigned char)*id++;
+	h *= 16777619u;
+	h &= 0xffffffffu;
+    }
+    return h;
+}
+
+/* 같은 id가 있으면 뒤에 나온 자판이 선택되도록 슬롯을 덮어 쓴다. */
+static void
+write_index(FILE* out)
+{
+    unsigned int hash[MAX_KEYBOARDS * 2];
+    int pos[MAX_KEYBOARDS * 2];
+    size_t size = 8;
+    size_t i, slot;
+
+    while (size < (size_t)n_keyboards * 2)
+	size *= 2;
+
+    memset(pos, 0, sizeof(pos));
+    for (i = 0; i < (size_t)n_keyboards; i++) {
+	unsigned int h = keyboard_id_hash(keyboards[i].id);
+
+	slot = h & (size - 1);
+	while (pos[slot] != 0) {
+	    if (hash[slot] == h && strcmp(keyboards[pos[slot] - 1].id, keyboards[i].id) == 0)
+		break;
+	    slot = (slot + 1) & (size - 1);
+	}
+	hash[slot] = h;
+	pos[slot] = i + 1;
+    }
+
+    fprintf(out, "\nstatic const HangulKeyboardIndexSlot hangul_builtin_keyboard_index[%zu] = {\n", size);
+    for (i = 0; i < size; i++) {
+	if (pos[i] != 0)
+	    fprintf(out, "    { 0x%08x, %d },\n", hash[i], pos[i]);
+	else
+	    fprintf(out, "    { 0, 0 },\n");
+    }
+    fprintf(out, "};\n");
+}
+
+static void
+write_header(FILE* out)
+{
+    int i, j, k;
+
+    fprintf(out,
+	    "/* 이 파일은 genkeyboard 프로그램이 data/keyboards 의 XML 파일에서\n"
+	    " * 생성한 것이다. 직접 수정하지 말고 XML 파일을 수정할 것. */\n");
+
+    for (i = 0; i < n_keyboards; i++) {
+	const Keyboard* keyboard = &keyboards[i];
+
+	for (j = 0; j < KEYBOARD_MAX_MAPS; j++) {
+	    if (!keyboard->has_table[j])
+		continue;
+
+	    fprintf(out, "\nstatic const ucschar hangul_keyboard_table_%s_%d[] = {\n",
+		    keyboard->ident, j);
+	    for (k = 0; k < KEYBOARD_TABLE_SIZE; k++) {
+		fprintf(out, "    0x%04x%c     /* 0x%02X", keyboard->table[j][k],
+			k + 1 < KEYBOARD_TABLE_SIZE ? ',' : ' ', k);
+		if (isgraph(k))
+		    fprintf(out, " %c", k);
+		fprintf(out, " */\n");
+	    }
+	    fprintf(out, "};\n");
+	}
+    }
+
+    for (i = 0; i < n_combinations; i++) {
+	const Combination* combination = &combinations[i];
+	size_t n;
+
+	if (combination->n == 0)
+	    die(combination->source, "empty combination", NULL);
+
+	fprintf(out, "\nstatic const HangulCombinationItem hangul_combination_table_%s[] = {\n",
+		combination->name);
+	for (n = 0; n < combination->n; n++) {
+	    fprintf(out, "    { 0x%08x, 0x%04x },\n",
+		    combination->items[n].key, combination->items[n].code);
+	}
+	fprintf(out, "};\n");
+
+	write_combination_hash(out, combination);
+    }
+
+    for (i = 0; i < n_keyboards; i++) {
+	const Keyboard* keyboard = &keyboards[i];
+
+	fprintf(out, "\nstatic const HangulKeyboard hangul_keyboard_builtin_%s = {\n",
+		keyboard->ident);
+	fprintf(out, "    (char*)");
+	write_string(out, keyboard->id);
+	fprintf(out, ",\n    (char*)N_(");
+	write_string(out, keyboard->name);
+	fprintf(out, "),\n    {");
+	for (j = 0; j < KEYBOARD_MAX_MAPS; j++) {
+	    if (keyboard->has_table[j])
+		fprintf(out, " (ucschar*)hangul_keyboard_table_%s_%d", keyboard->ident, j);
+	    else
+		fprintf(out, " NULL");
+	    fprintf(out, j + 1 < KEYBOARD_MAX_MAPS ? "," : " },\n    {");
+	}
+	for (j = 0; j < KEYBOARD_MAX_MAPS; j++) {
+	    int c = keyboard->combination[j];
+	    if (c >= 0)
+		fprintf(out, " (HangulCombination*)&hangul_combination_builtin_%s",
+			combinations[c].name);
+	    else
+		fprintf(out, " NULL");
+	    fprintf(out, j + 1 < KEYBOARD_MAX_MAPS ? "," : " },\n");
+	}
+	fprintf(out, "    %s,\n    true\n};\n", keyboard->type);
+    }
+
+    fprintf(out, "\nstatic const HangulKeyboard* hangul_builtin_keyboards[] = {\n");
+    for (i = 0; i < n_keyboards; i++)
+	fprintf(out, "    &hangul_keyboard_builtin_%s,\n", keyboards[i].ident);
+    fprintf(out, "};\n");
+
+    write_index(out);
+}
+
+int
+main(int argc, char* argv[])
+{
+    FILE* out;
+    int i, j;
+
+    if (argc > 0)
+	program_name = argv[0];
+
+    if (argc < 3) {
+	fprintf(stderr, "Usage: %s OUTPUT KEYBOARD_XML...\n", program_name);
+	return EXIT_FAILURE;
+    }
+
+    for (i = 2; i < argc; i++) {
+	ParseContext context = { NULL, NULL, ELEMENT_NONE, 0, NULL, 0 };
+	Keyboard* keyboard;
+
+	if (n_keyboards >= MAX_KEYBOARDS)
+	    die(argv[i], "too many keyboards", NULL);
+
+	keyboard = &keyboards[n_keyboards++];
+	for (j = 0; j < KEYBOARD_MAX_MAPS; j++)
+	    keyboard->combination[j] = -1;
+
+	context.keyboard = keyboard;
+	parse_file(&context, argv[i]);
+
+	if (keyboard->id[0] == '\0')
+	    die(argv[i], "not a keyboard file", NULL);
+	if (keyboard->name[0] == '\0')
+	    die(argv[i], "keyboard without name", NULL);
+	if (!keyboard->has_table[0])
+	    die(argv[i], "keyboard without map", NULL);
+
+	for (j = 0; j < n_keyboards - 1; j++) {
+	    if (strcmp(keyboards[j].ident, keyboard->ident) == 0)
+		die(argv[i], "duplicated keyboard id", keyboard->id);
+	}
+    }
+
+    /* 중간에 실패해서 불완전한 헤더가 남지 않도록 모든 파일을 읽은 후에
+     * 출력 파일을 연다. */
+    out = fopen(argv[1], "w");
+    if (out == NULL)
+	die(argv[1], "cannot open output file", NULL);
+
+    write_header(out);
+
+    if (fclose(out) != 0) {
+	remove(argv[1]);
+	die(argv[1], "write error", NULL);
+    }
+
+    return EXIT_SUCCESS;
+}
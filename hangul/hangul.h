@@ -69,12 +69,16 @@ void    hangul_syllable_to_jamo(ucschar syllable,
 				ucschar* jongseong);
 int     hangul_jamos_to_syllables(ucschar* dest, int destlen,
 				  const ucschar* src, int srclen);
+int     hangul_ucs4_to_utf8(char* dest, int destlen,
+			    const ucschar* src, int srclen);
 
 /* hangulinputcontext.c */
 typedef struct _HangulKeyboard        HangulKeyboard;
 typedef struct _HangulCombination     HangulCombination;
 typedef struct _HangulBuffer          HangulBuffer;
 typedef struct _HangulInputContext    HangulInputContext;
+typedef struct _HangulInputContextPool HangulInputContextPool;
+typedef struct _HangulICResult        HangulICResult;
 
 enum {
     HANGUL_OUTPUT_SYLLABLE,
@@ -93,6 +97,34 @@ enum {
     HANGUL_IC_OPTION_AUTO_REORDER,
     HANGUL_IC_OPTION_COMBI_ON_DOUBLE_STROKE,
     HANGUL_IC_OPTION_NON_CHOSEONG_COMBI,
+    HANGUL_IC_OPTION_TRANSITION_TABLE,
+    HANGUL_IC_OPTION_TRACE,
+};
+
+enum {
+    HANGUL_IC_STATE_SIZE_MAX = 320  /* hangul_ic_save_state() 결과의 최대 크기 */
+};
+
+enum {
+    HANGUL_IC_RESULT_CONSUMED        = 1 << 0,
+    HANGUL_IC_RESULT_COMMIT_CHANGED  = 1 << 1,
+    HANGUL_IC_RESULT_PREEDIT_CHANGED = 1 << 2,
+    HANGUL_IC_RESULT_EMPTY           = 1 << 3
+};
+
+/* hangul_ic_process_ex() 의 결과 */
+struct _HangulICResult {
+    unsigned int   flags;	    /* HANGUL_IC_RESULT_* */
+    int            commit_len;
+    int            preedit_len;
+    const ucschar* commit;
+    const ucschar* preedit;
+
+    /* 키를 처리하기 전의 preedit 스트링에서 바뀐 부분 */
+    int            preedit_prefix_len;   /* 바뀌지 않은 앞부분의 길이 */
+    int            preedit_removed;	     /* 그 뒤에서 지워진 글자 수 */
+    int            preedit_inserted_len; /* 그 자리에 새로 들어간 글자 수 */
+    const ucschar* preedit_inserted;
 };
 
 /* library */
@@ -123,7 +155,20 @@ bool hangul_combination_set_data(HangulCombination* combination,
 /* input context */
 HangulInputContext* hangul_ic_new(const char* keyboard);
 void hangul_ic_delete(HangulInputContext *hic);
+HangulInputContextPool* hangul_ic_pool_new(void);
+void hangul_ic_pool_delete(HangulInputContextPool* pool);
+HangulInputContext* hangul_ic_new_from_pool(HangulInputContextPool* pool,
+					    const char* keyboard);
+int  hangul_ic_save_state(HangulInputContext *hic, void *buf, int buflen);
+bool hangul_ic_restore_state(HangulInputContext *hic, const void *buf, int len);
+int  hangul_ic_dump_trace(HangulInputContext *hic, char *buf, int buflen);
 bool hangul_ic_process(HangulInputContext *hic, int ascii);
+bool hangul_ic_process_ex(HangulInputContext *hic, int ascii,
+			  HangulICResult *result);
+int  hangul_ic_process_keys(HangulInputContext *hic, const char *keys, int nkeys,
+			    ucschar *out, int outcap, int *outlen);
+int  hangul_ic_process_batch(HangulInputContext **hics, const int *keys, int n,
+			     bool *results, ucschar *out, int outcap, int *offsets);
 void hangul_ic_reset(HangulInputContext *hic);
 bool hangul_ic_backspace(HangulInputContext *hic);
 
@@ -146,18 +191,41 @@ void hangul_ic_connect_callback(HangulInputContext* hic, const char* event,
 
 const ucschar* hangul_ic_get_preedit_string(HangulInputContext *hic);
 const ucschar* hangul_ic_get_commit_string(HangulInputContext *hic);
+int hangul_ic_get_preedit_string_utf8(HangulInputContext *hic,
+				      char *buf, int buflen);
+int hangul_ic_get_commit_string_utf8(HangulInputContext *hic,
+				     char *buf, int buflen);
 const ucschar* hangul_ic_flush(HangulInputContext *hic);
+const ucschar* hangul_ic_get_preedit_string_len(HangulInputContext *hic,
+					       int *len);
+const ucschar* hangul_ic_get_commit_string_len(HangulInputContext *hic,
+					      int *len);
+const ucschar* hangul_ic_flush_len(HangulInputContext *hic, int *len);
 
 /* hanja.c */
 typedef struct _Hanja Hanja;
 typedef struct _HanjaList HanjaList;
 typedef struct _HanjaTable HanjaTable;
 
+enum {
+    HANJA_TABLE_STATS_EXACT_LOOKUPS,
+    HANJA_TABLE_STATS_PREFIX_LOOKUPS,
+    HANJA_TABLE_STATS_SUFFIX_LOOKUPS,
+    HANJA_TABLE_STATS_INDEX_PROBES,
+    HANJA_TABLE_STATS_BYTES_READ,
+    HANJA_TABLE_STATS_RECORDS_SCANNED,
+    HANJA_TABLE_STATS_MAX_RECORDS_SCANNED,
+    HANJA_TABLE_STATS_RESULTS,
+    HANJA_TABLE_STATS_COMMENT_LOADS,
+};
+
 HanjaTable*  hanja_table_load(const char *filename);
 HanjaList*   hanja_table_match_exact(const HanjaTable* table, const char *key);
 HanjaList*   hanja_table_match_prefix(const HanjaTable* table, const char *key);
 HanjaList*   hanja_table_match_suffix(const HanjaTable* table, const char *key);
 void         hanja_table_delete(HanjaTable *table);
+unsigned long hanja_table_get_stats(const HanjaTable* table, int item);
+void         hanja_table_reset_stats(HanjaTable* table);
 
 int          hanja_list_get_size(const HanjaList *list);
 const char*  hanja_list_get_key(const HanjaList *list);
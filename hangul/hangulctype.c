@@ -1726,3 +1726,75 @@ hangul_jamos_to_syllables(ucschar* dest, int destlen, const ucschar* src, int sr
 
     return destlen - outleft;
 }
+
+/**
+ * @ingroup hangulctype
+ * @brief UCS4 스트링을 UTF-8 스트링으로 변환
+ * @param dest UTF-8로 변환된 결과가 저장될 버퍼
+ * @param destlen 결과를 저장할 버퍼의 길이(바이트 단위)
+ * @param src 변환할 UCS4 스트링
+ * @param srclen 변환할 UCS4 스트링의 길이(ucschar 코드 단위)
+ * @return @a dest 에 저장한 바이트 수, 끝의 0은 포함하지 않는다.
+ *
+ * 이 함수는 iconv 를 사용하지 않고 @a src 를 UTF-8로 변환하여 @a dest 에
+ * 저장한다. @a srclen 이 -1이라면 @a src 는 0으로 끝나는 스트링으로 가정한다.
+ * @a destlen 이 0보다 크면 결과는 항상 0으로 끝나고, 버퍼가 부족하면
+ * 글자 중간에서 자르지 않고 들어갈 수 있는 글자까지만 변환한다.
+ * 유니코드 범위를 벗어나거나 surrogate에 해당하는 값은 건너뛴다.
+ */
+int
+hangul_ucs4_to_utf8(char* dest, int destlen, const ucschar* src, int srclen)
+{
+    unsigned char* d = (unsigned char*)dest;
+    int outleft;
+    int i;
+
+    if (dest == NULL || destlen <= 0)
+	return 0;
+
+    outleft = destlen - 1;
+    for (i = 0; srclen < 0 || i < srclen; i++) {
+	ucschar c = src[i];
+
+	if (srclen < 0 && c == 0)
+	    break;
+
+	if (c < 0x80) {
+	    if (outleft < 1)
+		break;
+	    d[0] = c;
+	    d += 1;
+	    outleft -= 1;
+	} else if (c < 0x800) {
+	    if (outleft < 2)
+		break;
+	    d[0] = 0xc0 | (c >> 6);
+	    d[1] = 0x80 | (c & 0x3f);
+	    d += 2;
+	    outleft -= 2;
+	} else if (c < 0x10000) {
+	    if (c >= 0xd800 && c <= 0xdfff)
+		continue;
+	    if (outleft < 3)
+		break;
+	    d[0] = 0xe0 | (c >> 12);
+	    d[1] = 0x80 | ((c >> 6) & 0x3f);
+	    d[2] = 0x80 | (c & 0x3f);
+	    d += 3;
+	    outleft -= 3;
+	} else if (c < 0x110000) {
+	    if (outleft < 4)
+		break;
+	    d[0] = 0xf0 | (c >> 18);
+	    d[1] = 0x80 | ((c >> 12) & 0x3f);
+	    d[2] = 0x80 | ((c >> 6) & 0x3f);
+	    d[3] = 0x80 | (c & 0x3f);
+	    d += 4;
+	    outleft -= 4;
+	}
+    }
+
+    *d = '\0';
+
+    return (char*)d - dest;
+}
@@ -19,6 +19,7 @@
 #include <config.h>
 #endif
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #ifndef _WIN32
@@ -187,6 +188,12 @@ typedef bool   (*HangulOnTransition) (HangulInputContext*,
 				      ucschar,
 				      const ucschar*,
 				      void*);
+typedef void   (*HangulOnCommit)     (HangulInputContext*,
+				      const ucschar*,
+				      int,
+				      void*);
+
+typedef struct _HangulAutomaton HangulAutomaton;
 
 struct _HangulBuffer {
     ucschar choseong;
@@ -197,29 +204,92 @@ struct _HangulBuffer {
     int     index;
 };
 
-struct _HangulInputContext {
-    int type;
-
-    const HangulKeyboard*    keyboard;
-    int tableid;
-
-    HangulBuffer buffer;
-    int output_mode;
-
+/* 조합 결과 스트링. 한번의 키 처리 결과만 담으면 되므로 pool에서
+ * 만든 @ref HangulInputContext 는 이 버퍼를 pool 전체가 공유한다.
+ * owner 는 마지막으로 이 버퍼에 결과를 쓴 입력 상태다. */
+typedef struct _HangulICOutput {
+    const HangulInputContext* owner;
+    int preedit_len;
+    int commit_len;
+    int flushed_len;
     ucschar preedit_string[64];
     ucschar commit_string[64];
     ucschar flushed_string[64];
+} HangulICOutput;
 
+/* 콜백은 연결할 때에만 따로 할당하고 그 전에는 모두 NULL인
+ * hangul_ic_no_callbacks 를 가리킨다. */
+typedef struct _HangulICCallbacks {
     HangulOnTranslate   on_translate;
     void*               on_translate_data;
 
     HangulOnTransition  on_transition;
     void*               on_transition_data;
 
+    HangulOnCommit      on_commit;
+    void*               on_commit_data;
+} HangulICCallbacks;
+
+static const HangulICCallbacks hangul_ic_no_callbacks = {
+    NULL, NULL, NULL, NULL, NULL, NULL
+};
+
+/* HANGUL_IC_OPTION_TRACE 옵션을 켜면 최근 키 입력을 링 버퍼에 기록한다.
+ * 기록을 다시 재현하려면 처음 상태가 필요하므로 링의 앞쪽 절반과 뒤쪽
+ * 절반을 새로 쓰기 시작할 때마다 hangul_ic_save_state() 로 상태를
+ * 저장해 둔다. 그러면 덮어쓰지 않은 절반과 그 뒤의 기록은 항상 재현할
+ * 수 있다. 자판이나 옵션이 바뀌면 처음부터 다시 기록한다. */
+#define HANGUL_IC_TRACE_SIZE 256
+#define HANGUL_IC_TRACE_HALF (HANGUL_IC_TRACE_SIZE / 2)
+
+enum {
+    HANGUL_IC_TRACE_RESET = -1,
+    HANGUL_IC_TRACE_FLUSH = -2
+};
+
+typedef struct _HangulICTraceEntry {
+    int           key;	    /* ASCII 키, 또는 HANGUL_IC_TRACE_RESET, FLUSH */
+    ucschar       ch;	    /* 자판으로 바꾼 글자 */
+    ucschar       choseong;  /* 처리한 후의 조합 상태 */
+    ucschar       jungseong;
+    ucschar       jongseong;
+    unsigned char result;
+    unsigned char commit_len;
+} HangulICTraceEntry;
+
+typedef struct _HangulICTrace {
+    unsigned int head;	    /* 다음에 기록할 위치 */
+    unsigned int count;	    /* 기록된 이벤트의 수 */
+    const HangulKeyboard* keyboard;
+    int config;
+    int state_len[2];
+    unsigned char state[2][HANGUL_IC_STATE_SIZE_MAX];
+    HangulICTraceEntry entries[HANGUL_IC_TRACE_SIZE];
+} HangulICTrace;
+
+/* 세션마다 남아 있어야 하는 조합 상태만 담는다. 결과 스트링과 콜백,
+ * 상태 전이표는 포인터로 따로 두어서 많은 입력 상태를 만들어 두어도
+ * 메모리를 적게 사용하도록 한다. */
+struct _HangulInputContext {
+    const HangulKeyboard*    keyboard;
+    HangulICOutput*          output;
+    const HangulICCallbacks* callbacks;
+    HangulAutomaton*         automaton;
+    HangulInputContextPool*  pool;
+    HangulICTrace*           trace;
+
+    HangulBuffer buffer;
+
+    int automaton_state;
+    unsigned int automaton_generation;
+
+    int tableid;
+    unsigned int output_mode : 1;
     unsigned int use_jamo_mode_only : 1;
     unsigned int option_auto_reorder : 1;
     unsigned int option_combi_on_double_stroke : 1;
     unsigned int option_non_choseong_combi : 1;
+    unsigned int option_transition_table : 1;
 };
 
 static void    hangul_buffer_push(HangulBuffer *buffer, ucschar ch);
@@ -231,6 +301,8 @@ static int     hangul_buffer_get_string(HangulBuffer *buffer, ucschar*buf, int b
 static int     hangul_buffer_get_jamo_string(HangulBuffer *buffer, ucschar *buf, int buflen);
 
 static void    hangul_ic_flush_internal(HangulInputContext *hic);
+static bool    hangul_ic_backspace_internal(HangulInputContext *hic);
+static void    hangul_ic_output_clear(HangulICOutput *output);
 
 
 static bool
@@ -457,7 +529,7 @@ static inline bool
 hangul_ic_push(HangulInputContext *hic, ucschar c)
 {
     ucschar buf[64] = { 0, };
-    if (hic->on_transition != NULL) {
+    if (hic->callbacks->on_transition != NULL) {
 	ucschar cho, jung, jong;
 	if (hangul_is_choseong(c)) {
 	    cho  = c;
@@ -477,7 +549,7 @@ hangul_ic_push(HangulInputContext *hic, ucschar c)
 	}
 
 	hangul_jaso_to_string(cho, jung, jong, buf, N_ELEMENTS(buf));
-	if (!hic->on_transition(hic, c, buf, hic->on_transition_data)) {
+	if (!hic->callbacks->on_transition(hic, c, buf, hic->callbacks->on_transition_data)) {
 	    hangul_ic_flush_internal(hic);
 	    return false;
 	}
@@ -488,6 +560,12 @@ hangul_ic_push(HangulInputContext *hic, ucschar c)
 	}
     }
 
+    /* 더 쌓을 곳이 없으면 지금까지 조합한 글자를 내보낸다. */
+    if (hic->buffer.index + 1 >= (int)N_ELEMENTS(hic->buffer.stack)) {
+	hangul_ic_flush_internal(hic);
+	return false;
+    }
+
     hangul_buffer_push(&hic->buffer, c);
     return true;
 }
@@ -508,49 +586,75 @@ static inline void
 hangul_ic_save_preedit_string(HangulInputContext *hic)
 {
     if (hic->output_mode == HANGUL_OUTPUT_JAMO) {
-	hangul_buffer_get_jamo_string(&hic->buffer,
-				      hic->preedit_string,
-				      N_ELEMENTS(hic->preedit_string));
+	hic->output->preedit_len =
+	    hangul_buffer_get_jamo_string(&hic->buffer,
+					  hic->output->preedit_string,
+					  N_ELEMENTS(hic->output->preedit_string));
     } else {
-	hangul_buffer_get_string(&hic->buffer,
-				 hic->preedit_string,
-				 N_ELEMENTS(hic->preedit_string));
+	hic->output->preedit_len =
+	    hangul_buffer_get_string(&hic->buffer,
+				     hic->output->preedit_string,
+				     N_ELEMENTS(hic->output->preedit_string));
     }
 }
 
+/* pool의 입력 상태들은 결과 스트링 버퍼를 공유하므로 다른 입력 상태가
+ * 마지막으로 사용했으면 이 입력 상태의 preedit 스트링을 다시 만든다.
+ * commit, flush 스트링은 이미 다른 입력 상태의 것이므로 비운다. */
 static inline void
-hangul_ic_append_commit_string(HangulInputContext *hic, ucschar ch)
+hangul_ic_claim_output(HangulInputContext *hic)
 {
-    int i;
+    HangulICOutput* output = hic->output;
 
-    for (i = 0; i < N_ELEMENTS(hic->commit_string); i++) {
-	if (hic->commit_string[i] == 0)
-	    break;
+    if (output->owner == hic)
+	return;
+
+    output->owner = hic;
+    hangul_ic_output_clear(output);
+    hangul_ic_save_preedit_string(hic);
+}
+
+static inline void
+hangul_ic_append_commit_string(HangulInputContext *hic, ucschar ch)
+{
+    if (hic->callbacks->on_commit != NULL) {
+	hic->callbacks->on_commit(hic, &ch, 1, hic->callbacks->on_commit_data);
+	return;
     }
 
-    if (i + 1 < N_ELEMENTS(hic->commit_string)) {
-	hic->commit_string[i++] = ch;
-	hic->commit_string[i] = 0;
+    if (hic->output->commit_len + 1 < N_ELEMENTS(hic->output->commit_string)) {
+	hic->output->commit_string[hic->output->commit_len++] = ch;
+	hic->output->commit_string[hic->output->commit_len] = 0;
     }
 }
 
 static inline void
 hangul_ic_save_commit_string(HangulInputContext *hic)
 {
-    ucschar *string = hic->commit_string;
-    int len = N_ELEMENTS(hic->commit_string);
+    ucschar *string = hic->output->commit_string + hic->output->commit_len;
+    int len = N_ELEMENTS(hic->output->commit_string) - hic->output->commit_len;
 
-    while (len > 0) {
-	if (*string == 0)
-	    break;
-	len--;
-	string++;
+    if (hic->callbacks->on_commit != NULL) {
+	ucschar buf[N_ELEMENTS(hic->output->commit_string)];
+	int n;
+
+	if (hic->output_mode == HANGUL_OUTPUT_JAMO) {
+	    n = hangul_buffer_get_jamo_string(&hic->buffer, buf, N_ELEMENTS(buf));
+	} else {
+	    n = hangul_buffer_get_string(&hic->buffer, buf, N_ELEMENTS(buf));
+	}
+
+	hangul_buffer_clear(&hic->buffer);
+
+	if (n > 0)
+	    hic->callbacks->on_commit(hic, buf, n, hic->callbacks->on_commit_data);
+	return;
     }
 
     if (hic->output_mode == HANGUL_OUTPUT_JAMO) {
-	hangul_buffer_get_jamo_string(&hic->buffer, string, len);
+	hic->output->commit_len += hangul_buffer_get_jamo_string(&hic->buffer, string, len);
     } else {
-	hangul_buffer_get_string(&hic->buffer, string, len);
+	hic->output->commit_len += hangul_buffer_get_string(&hic->buffer, string, len);
     }
 
     hangul_buffer_clear(&hic->buffer);
@@ -1047,234 +1151,1371 @@ flush:
     return false;
 }
 
-/**
- * @ingroup hangulic
- * @brief 키 입력을 처리하여 실제로 한글 조합을 하는 함수
- * @param hic @ref HangulInputContext 오브젝트
- * @param ascii 키 이벤트
- * @return @ref HangulInputContext 가 이 키를 사용했으면 true,
- *	     사용하지 않았으면 false
- *
- * ascii 값으로 주어진 키 이벤트를 받아서 내부의 한글 조합 상태를
- * 변화시키고, preedit, commit 스트링을 저장한다.
+/* 상태 전이표
  *
- * libhangul의 키 이벤트 프로세스는 ASCII 코드 값을 기준으로 처리한다.
- * 이 키 값은 US Qwerty 자판 배열에서의 키 값에 해당한다.
- * 따라서 유럽어 자판을 사용하는 경우에는 해당 키의 ASCII 코드를 직접
- * 전달하면 안되고, 그 키가 US Qwerty 자판이었을 경우에 발생할 수 있는 
- * ASCII 코드 값을 주어야 한다.
- * 또한 ASCII 코드 이므로 Shift 상태는 대문자로 전달이 된다.
- * Capslock이 눌린 경우에는 대소문자를 뒤바꾸어 보내주지 않으면 
- * 마치 Shift가 눌린 것 처럼 동작할 수 있으므로 주의한다.
- * preedit, commit 스트링은 hangul_ic_get_preedit_string(),
- * hangul_ic_get_commit_string() 함수를 이용하여 구할 수 있다.
- * 
- * 이 함수의 사용법에 대한 설명은 @ref hangulicusage 부분을 참조한다.
+ * hangul_ic_process_jamo(), hangul_ic_process_jaso(),
+ * hangul_ic_process_romaja() 의 결과는 버퍼의 상태와 입력된 키, 그리고
+ * 자판의 조합 규칙과 옵션으로만 결정된다.
+ * 그러므로 한번 계산한 (버퍼 상태, 키) 쌍의 결과를 표에 기록해 두면
+ * 다음부터는 표를 한번 읽어서 다음 상태와 commit 스트링을 구할 수 있다.
  *
- * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ * 도달할 수 있는 모든 상태를 미리 계산하면 자판에 따라 수만개의 상태가
+ * 생기므로, 표는 처음 만나는 상태와 키를 계산하면서 채워 나간다.
+ * 실제 입력에서 나오는 상태는 많지 않으므로 대부분의 키는 표에서
+ * 처리된다. 표가 가득 차면 비우고 다시 시작한다.
+ * 조합 함수는 표를 채울 때와 표로 처리할 수 없는 키를 처리할 때
+ * 그대로 사용하므로 두 방법의 결과는 항상 같다.
  */
-bool
-hangul_ic_process(HangulInputContext *hic, int ascii)
+
+#define HANGUL_AUTOMATON_MAX_STATES	8192
+#define HANGUL_AUTOMATON_MAX_COMMITS	0x3fff
+
+#define HANGUL_TRANSITION_UNKNOWN	0xffff	/* 아직 계산하지 않음 */
+#define HANGUL_TRANSITION_REJECT	0x8000	/* 키를 사용하지 않음 */
+#define HANGUL_TRANSITION_NO_PREEDIT	0x4000	/* preedit 스트링이 없음 */
+#define HANGUL_TRANSITION_COMMIT_MASK	0x3fff
+
+typedef struct _HangulTransition HangulTransition;
+
+struct _HangulTransition {
+    uint16_t next;
+    uint16_t commit;
+};
+
+struct _HangulAutomaton {
+    const HangulKeyboard* keyboard;	/* 참조를 가지고 있다 */
+    long keyboard_serial;
+    int tableid;
+    int output_mode;
+    unsigned int options;
+    int type;
+
+    /* ASCII 키를 같은 결과를 내는 키의 종류로 바꾸는 표,
+     * 0은 표로 처리하지 않는 키 */
+    unsigned char key_class[128];
+    ucschar class_char[128];
+    int class_ascii[128];
+    int nclasses;
+
+    HangulBuffer* states;
+    int nstates;
+    int states_alloc;
+    int* state_hash;		/* 상태 번호 + 1, 0은 빈 슬롯 */
+
+    HangulTransition* table;	/* nstates * nclasses */
+    int table_alloc;
+
+    /* preedit 스트링과 commit 스트링은 각각 하나의 배열에 모아서 저장하고
+     * 시작 위치만 기억한다. i번째 스트링은 offset[i] 에서
+     * offset[i + 1] 까지다. preedit 스트링은 상태 번호를 사용한다. */
+    ucschar* preedit;
+    int preedit_alloc;
+    uint32_t* preedit_offset;
+
+    ucschar* commit;
+    int commit_alloc;
+    uint32_t* commit_offset;
+    int ncommits;
+    int* commit_hash;		/* commit 번호, 0은 빈 슬롯 */
+
+    /* 표를 비울 때마다 증가한다. pool의 입력 상태들은 표를 공유하므로
+     * 이 값이 바뀌었으면 기억하고 있던 상태 번호를 다시 찾아야 한다. */
+    unsigned int generation;
+
+    /* 표를 사용하는 입력 상태와 pool 의 수. pool 은 한 스레드에서만
+     * 사용하므로 atomic 하지 않아도 된다. */
+    int ref_count;
+};
+
+#define HANGUL_AUTOMATON_STATE_HASH_SIZE  (HANGUL_AUTOMATON_MAX_STATES * 2)
+#define HANGUL_AUTOMATON_COMMIT_HASH_SIZE ((HANGUL_AUTOMATON_MAX_COMMITS + 1) * 2)
+
+static unsigned int
+hangul_ic_get_option_bits(const HangulInputContext* hic)
 {
-    ucschar c;
+    return (hic->option_auto_reorder << 0) |
+	   (hic->option_combi_on_double_stroke << 1) |
+	   (hic->option_non_choseong_combi << 2);
+}
 
-    if (hic == NULL)
-	return false;
+static unsigned
+hangul_ucs_hash(unsigned h, const ucschar* str, int len)
+{
+    int i;
 
-    hic->preedit_string[0] = 0;
-    hic->commit_string[0] = 0;
+    for (i = 0; i < len; i++)
+	h = (h ^ str[i]) * 16777619u;
 
-    c = hangul_keyboard_map_to_char(hic->keyboard, hic->tableid, ascii);
-    if (hic->on_translate != NULL)
-	hic->on_translate(hic, ascii, &c, hic->on_translate_data);
+    return h;
+}
 
-    if (ascii == '\b') {
-	return hangul_ic_backspace(hic);
-    }
+static unsigned
+hangul_buffer_hash(const HangulBuffer* buffer)
+{
+    unsigned h = 2166136261u;
 
-    int type = hangul_keyboard_get_type(hic->keyboard);
-    switch (type) {
-    case HANGUL_KEYBOARD_TYPE_JASO:
-    case HANGUL_KEYBOARD_TYPE_JASO_YET:
-	return hangul_ic_process_jaso(hic, c);
-    case HANGUL_KEYBOARD_TYPE_ROMAJA:
-	return hangul_ic_process_romaja(hic, ascii, c);
-    default:
-	return hangul_ic_process_jamo(hic, c);
-    }
+    h = (h ^ buffer->choseong) * 16777619u;
+    h = (h ^ buffer->jungseong) * 16777619u;
+    h = (h ^ buffer->jongseong) * 16777619u;
+    h = hangul_ucs_hash(h, buffer->stack, buffer->index + 1);
+
+    return h ^ (h >> 15);
 }
 
-/**
- * @ingroup hangulic
- * @brief 현재 상태의 preedit string을 구하는 함수
- * @param hic preedit string을 구하고자하는 입력 상태 object
- * @return UCS4 preedit 스트링, 이 스트링은 @a hic 내부의 데이터이므로 
- *         수정하거나 free해서는 안된다.
- * 
- * 이 함수는  @a hic 내부의 현재 상태의 preedit string을 리턴한다.
- * 따라서 hic가 다른 키 이벤트를 처리하고 나면 그 내용이 바뀔 수 있다.
- * 
- * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
- */
-const ucschar*
-hangul_ic_get_preedit_string(HangulInputContext *hic)
+/* stack에서 index 위의 값은 사용하지 않으므로 비교하지 않는다. */
+static bool
+hangul_buffer_equal(const HangulBuffer* a, const HangulBuffer* b)
 {
-    if (hic == NULL)
-	return NULL;
+    int i;
+
+    if (a->choseong != b->choseong ||
+	a->jungseong != b->jungseong ||
+	a->jongseong != b->jongseong ||
+	a->index != b->index)
+	return false;
+
+    for (i = 0; i <= a->index; i++) {
+	if (a->stack[i] != b->stack[i])
+	    return false;
+    }
 
-    return hic->preedit_string;
+    return true;
 }
 
-/**
- * @ingroup hangulic
- * @brief 현재 상태의 commit string을 구하는 함수
- * @param hic commit string을 구하고자하는 입력 상태 object
- * @return UCS4 commit 스트링, 이 스트링은 @a hic 내부의 데이터이므로 
- *         수정하거나 free해서는 안된다.
- * 
- * 이 함수는  @a hic 내부의 현재 상태의 commit string을 리턴한다.
- * 따라서 hic가 다른 키 이벤트를 처리하고 나면 그 내용이 바뀔 수 있다.
- *
- * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
- */
-const ucschar*
-hangul_ic_get_commit_string(HangulInputContext *hic)
+static bool
+hangul_automaton_reserve(void** array, int* alloc, int need, size_t size)
 {
-    if (hic == NULL)
-	return NULL;
+    void* p;
+    int n;
+
+    if (need <= *alloc)
+	return true;
 
-    return hic->commit_string;
+    n = *alloc > 0 ? *alloc : 256;
+    while (n < need)
+	n *= 2;
+
+    p = realloc(*array, n * size);
+    if (p == NULL)
+	return false;
+
+    *array = p;
+    *alloc = n;
+    return true;
 }
 
-/**
- * @ingroup hangulic
- * @brief @ref HangulInputContext 를 초기상태로 되돌리는 함수
- * @param hic @ref HangulInputContext 를 가리키는 포인터
- * 
- * 이 함수는 @a hic가 가리키는 @ref HangulInputContext 의 상태를 
- * 처음 상태로 되돌린다. preedit 스트링, commit 스트링, flush 스트링이
- * 없어지고, 입력되었던 키에 대한 기록이 없어진다.
- * 영어 상태로 바뀌는 것이 아니다.
- *
- * 비교: hangul_ic_flush()
- *
- * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
- */
-void
-hangul_ic_reset(HangulInputContext *hic)
+/* 참조를 하나 놓고, 마지막 참조였으면 표를 해제한다. */
+static void
+hangul_automaton_delete(HangulAutomaton* automaton)
 {
-    if (hic == NULL)
+    if (automaton == NULL)
 	return;
 
-    hic->preedit_string[0] = 0;
-    hic->commit_string[0] = 0;
-    hic->flushed_string[0] = 0;
+    if (--automaton->ref_count > 0)
+	return;
 
-    hangul_buffer_clear(&hic->buffer);
+    hangul_keyboard_unref(automaton->keyboard);
+    free(automaton->states);
+    free(automaton->state_hash);
+    free(automaton->table);
+    free(automaton->preedit);
+    free(automaton->preedit_offset);
+    free(automaton->commit);
+    free(automaton->commit_offset);
+    free(automaton->commit_hash);
+    free(automaton);
 }
 
-/* append current preedit to the commit buffer.
- * this function does not clear previously made commit string. */
+static int
+hangul_automaton_add_state(HangulAutomaton* automaton,
+			   const HangulBuffer* buffer);
+
+/* 표를 비우고 빈 버퍼 상태만 남긴다. 빈 버퍼는 항상 0번 상태다. */
 static void
-hangul_ic_flush_internal(HangulInputContext *hic)
+hangul_automaton_clear(HangulAutomaton* automaton)
 {
-    hic->preedit_string[0] = 0;
-
-    hangul_ic_save_commit_string(hic);
-    hangul_buffer_clear(&hic->buffer);
+    HangulBuffer empty;
+
+    memset(automaton->state_hash, 0,
+	   HANGUL_AUTOMATON_STATE_HASH_SIZE * sizeof(automaton->state_hash[0]));
+    memset(automaton->commit_hash, 0,
+	   HANGUL_AUTOMATON_COMMIT_HASH_SIZE * sizeof(automaton->commit_hash[0]));
+    automaton->nstates = 0;
+    automaton->ncommits = 0;
+    automaton->generation++;
+    automaton->preedit_offset[0] = 0;
+    automaton->commit_offset[0] = 0;
+    automaton->commit_offset[1] = 0;
+
+    hangul_buffer_clear(&empty);
+    hangul_automaton_add_state(automaton, &empty);
 }
 
-/**
- * @ingroup hangulic
- * @brief @ref HangulInputContext 의 입력 상태를 완료하는 함수
- * @param hic @ref HangulInputContext 를 가리키는 포인터
- * @return 조합 완료된 스트링, 스트링의 길이가 0이면 조합 완료된 스트링이 
- *	  없는 것
- *
- * 이 함수는 @a hic가 가리키는 @ref HangulInputContext 의 입력 상태를 완료한다.
- * 조합중이던 스트링을 완성하여 리턴한다. 그리고 입력 상태가 초기 상태로 
- * 되돌아 간다. 조합중이던 글자를 강제로 commit하고 싶을때 사용하는 함수다.
- * 보통의 경우 입력 framework에서 focus가 나갈때 이 함수를 불러서 마지막 
- * 상태를 완료해야 조합중이던 글자를 잃어버리지 않게 된다.
- *
- * 비교: hangul_ic_reset()
- *
- * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
- */
-const ucschar*
-hangul_ic_flush(HangulInputContext *hic)
+static int
+hangul_automaton_find_state(const HangulAutomaton* automaton,
+			    const HangulBuffer* buffer, unsigned* slot)
 {
-    if (hic == NULL)
-	return NULL;
+    const unsigned mask = HANGUL_AUTOMATON_STATE_HASH_SIZE - 1;
+    unsigned i;
+
+    i = hangul_buffer_hash(buffer) & mask;
+    while (automaton->state_hash[i] != 0) {
+	int id = automaton->state_hash[i] - 1;
+	if (hangul_buffer_equal(&automaton->states[id], buffer))
+	    return id;
+	i = (i + 1) & mask;
+    }
 
-    // get the remaining string and clear the buffer
-    hic->preedit_string[0] = 0;
-    hic->commit_string[0] = 0;
-    hic->flushed_string[0] = 0;
+    if (slot != NULL)
+	*slot = i;
 
-    if (hic->output_mode == HANGUL_OUTPUT_JAMO) {
-	hangul_buffer_get_jamo_string(&hic->buffer, hic->flushed_string,
-				 N_ELEMENTS(hic->flushed_string));
+    return -1;
+}
+
+/* 상태를 찾아보고 없으면 새로 추가한다. 표가 가득 차면 -1을 리턴한다. */
+static int
+hangul_automaton_add_state(HangulAutomaton* automaton,
+			   const HangulBuffer* buffer)
+{
+    ucschar buf[64];
+    unsigned slot = 0;
+    int len;
+    int id;
+    int k;
+
+    id = hangul_automaton_find_state(automaton, buffer, &slot);
+    if (id >= 0)
+	return id;
+
+    if (automaton->nstates >= HANGUL_AUTOMATON_MAX_STATES)
+	return -1;
+
+    id = automaton->nstates;
+    if (!hangul_automaton_reserve((void**)&automaton->states,
+				  &automaton->states_alloc, id + 1,
+				  sizeof(automaton->states[0])))
+	return -1;
+
+    if (!hangul_automaton_reserve((void**)&automaton->table,
+				  &automaton->table_alloc,
+				  (id + 1) * automaton->nclasses,
+				  sizeof(automaton->table[0])))
+	return -1;
+
+    if (automaton->output_mode == HANGUL_OUTPUT_JAMO) {
+	len = hangul_buffer_get_jamo_string((HangulBuffer*)buffer,
+					    buf, N_ELEMENTS(buf));
     } else {
-	hangul_buffer_get_string(&hic->buffer, hic->flushed_string,
-				 N_ELEMENTS(hic->flushed_string));
+	len = hangul_buffer_get_string((HangulBuffer*)buffer,
+				       buf, N_ELEMENTS(buf));
     }
 
-    hangul_buffer_clear(&hic->buffer);
+    if (!hangul_automaton_reserve((void**)&automaton->preedit,
+				  &automaton->preedit_alloc,
+				  automaton->preedit_offset[id] + len,
+				  sizeof(automaton->preedit[0])))
+	return -1;
+
+    /* 빈 preedit 스트링이면 아직 preedit 배열이 없을 수 있다. */
+    if (len > 0)
+	memcpy(automaton->preedit + automaton->preedit_offset[id], buf,
+	       len * sizeof(buf[0]));
+    automaton->preedit_offset[id + 1] = automaton->preedit_offset[id] + len;
+
+    for (k = 0; k < automaton->nclasses; k++) {
+	automaton->table[id * automaton->nclasses + k].next =
+	    HANGUL_TRANSITION_UNKNOWN;
+    }
+
+    automaton->states[id] = *buffer;
+    automaton->state_hash[slot] = id + 1;
+    automaton->nstates++;
 
-    return hic->flushed_string;
+    return id;
 }
 
-/**
- * @ingroup hangulic
- * @brief @ref HangulInputContext 가 backspace 키를 처리하도록 하는 함수
- * @param hic @ref HangulInputContext 를 가리키는 포인터
- * @return @a hic가 키를 사용했으면 true, 사용하지 않았으면 false
- * 
- * 이 함수는 @a hic가 가리키는 @ref HangulInputContext 의 조합중이던 글자를
- * 뒤에서부터 하나 지우는 기능을 한다. backspace 키를 눌렀을 때 발생하는 
- * 동작을 한다. 따라서 이 함수를 부르고 나면 preedit string이 바뀌므로
- * 반드시 업데이트를 해야 한다.
- *
- * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
- */
-bool
-hangul_ic_backspace(HangulInputContext *hic)
+/* commit 스트링은 종류가 많지 않으므로 같은 것은 한번만 저장한다.
+ * 0번은 commit 스트링이 없는 경우로 사용한다. */
+static int
+hangul_automaton_add_commit(HangulAutomaton* automaton,
+			    const ucschar* str, int len)
 {
-    int ret;
+    const unsigned mask = HANGUL_AUTOMATON_COMMIT_HASH_SIZE - 1;
+    uint32_t* offset = automaton->commit_offset;
+    unsigned i;
+    int id;
+
+    i = hangul_ucs_hash(2166136261u, str, len) & mask;
+    while (automaton->commit_hash[i] != 0) {
+	id = automaton->commit_hash[i];
+	if (offset[id + 1] - offset[id] == len &&
+	    memcmp(automaton->commit + offset[id], str, len * sizeof(str[0])) == 0)
+	    return id;
+	i = (i + 1) & mask;
+    }
 
-    if (hic == NULL)
-	return false;
+    id = automaton->ncommits + 1;
+    if (id > HANGUL_AUTOMATON_MAX_COMMITS)
+	return -1;
 
-    hic->preedit_string[0] = 0;
-    hic->commit_string[0] = 0;
+    if (!hangul_automaton_reserve((void**)&automaton->commit,
+				  &automaton->commit_alloc,
+				  offset[id] + len,
+				  sizeof(automaton->commit[0])))
+	return -1;
 
-    ret = hangul_buffer_backspace(&hic->buffer);
-    if (ret)
-	hangul_ic_save_preedit_string(hic);
-    return ret;
+    if (len > 0)
+	memcpy(automaton->commit + offset[id], str, len * sizeof(str[0]));
+    offset[id + 1] = offset[id] + len;
+    automaton->commit_hash[i] = id;
+    automaton->ncommits++;
+
+    return id;
 }
 
-/**
- * @ingroup hangulic
- * @brief @ref HangulInputContext 가 조합중인 글자를 가지고 있는지 확인하는 함수
- * @param hic @ref HangulInputContext 를 가리키는 포인터
- *
- * @ref HangulInputContext 가 조합중인 글자가 있으면 true를 리턴한다.
- *
- * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
- */
-bool
-hangul_ic_is_empty(HangulInputContext *hic)
+/* 같은 상태에서 항상 같은 결과를 내는 키인지 확인한다.
+ * 로마자 자판은 글자 외에 대문자 여부와 x 키를 따로 처리한다. */
+static bool
+hangul_automaton_same_class(const HangulAutomaton* automaton, int k,
+			    int ascii, ucschar c)
 {
-    return hangul_buffer_is_empty(&hic->buffer);
-}
+    int other = automaton->class_ascii[k];
 
-/**
- * @ingroup hangulic
- * @brief @ref HangulInputContext 가 조합중인 초성을 가지고 있는지 확인하는 함수
- * @param hic @ref HangulInputContext 를 가리키는 포인터
- *
+    if (automaton->class_char[k] != c)
+	return false;
+
+    if (automaton->type == HANGUL_KEYBOARD_TYPE_ROMAJA) {
+	if ((isupper(other) != 0) != (isupper(ascii) != 0))
+	    return false;
+	if ((other == 'x' || other == 'X') != (ascii == 'x' || ascii == 'X'))
+	    return false;
+    }
+
+    return true;
+}
+
+static HangulAutomaton*
+hangul_automaton_new(const HangulInputContext* hic)
+{
+    HangulAutomaton* automaton;
+    int ascii;
+    int k;
+
+    if (hic->keyboard == NULL)
+	return NULL;
+
+    automaton = calloc(1, sizeof(HangulAutomaton));
+    if (automaton == NULL)
+	return NULL;
+
+    automaton->ref_count = 1;
+    automaton->keyboard = hangul_keyboard_ref(hic->keyboard);
+    automaton->keyboard_serial = hangul_keyboard_get_serial(hic->keyboard);
+    automaton->tableid = hic->tableid;
+    automaton->output_mode = hic->output_mode;
+    automaton->options = hangul_ic_get_option_bits(hic);
+    automaton->type = hangul_keyboard_get_type(hic->keyboard);
+
+    /* 같은 글자를 내는 키는 같은 종류로 묶는다. 자판에 없는 키도
+     * 조합중인 글자를 완성하는 결과가 같으므로 표로 처리한다. */
+    automaton->nclasses = 1;
+    for (ascii = 0; ascii < N_ELEMENTS(automaton->key_class); ascii++) {
+	ucschar c;
+
+	if (ascii == '\b')
+	    continue;
+
+	c = hangul_keyboard_map_to_char(hic->keyboard, hic->tableid, ascii);
+	for (k = 1; k < automaton->nclasses; k++) {
+	    if (hangul_automaton_same_class(automaton, k, ascii, c))
+		break;
+	}
+
+	if (k == automaton->nclasses) {
+	    automaton->class_char[k] = c;
+	    automaton->class_ascii[k] = ascii;
+	    automaton->nclasses++;
+	}
+	automaton->key_class[ascii] = k;
+    }
+
+    automaton->state_hash = malloc(HANGUL_AUTOMATON_STATE_HASH_SIZE *
+				   sizeof(automaton->state_hash[0]));
+    automaton->commit_hash = malloc(HANGUL_AUTOMATON_COMMIT_HASH_SIZE *
+				    sizeof(automaton->commit_hash[0]));
+    automaton->preedit_offset = malloc((HANGUL_AUTOMATON_MAX_STATES + 1) *
+				       sizeof(automaton->preedit_offset[0]));
+    automaton->commit_offset = malloc((HANGUL_AUTOMATON_MAX_COMMITS + 2) *
+				      sizeof(automaton->commit_offset[0]));
+    if (automaton->state_hash == NULL || automaton->commit_hash == NULL ||
+	automaton->preedit_offset == NULL || automaton->commit_offset == NULL) {
+	hangul_automaton_delete(automaton);
+	return NULL;
+    }
+
+    hangul_automaton_clear(automaton);
+    if (automaton->nstates != 1) {
+	hangul_automaton_delete(automaton);
+	return NULL;
+    }
+
+    return automaton;
+}
+
+static bool
+hangul_automaton_match(const HangulAutomaton* automaton,
+		       const HangulInputContext* hic)
+{
+    return automaton->keyboard == hic->keyboard &&
+	   automaton->keyboard_serial == hangul_keyboard_get_serial(hic->keyboard) &&
+	   automaton->tableid == hic->tableid &&
+	   automaton->output_mode == hic->output_mode &&
+	   automaton->options == hangul_ic_get_option_bits(hic);
+}
+
+/* state 상태에서 k 종류의 키를 입력한 결과를 조합 함수로 계산하여
+ * 표에 기록한다. 표가 가득 차면 표를 비우고 false를 리턴한다. */
+static bool
+hangul_automaton_add_transition(HangulAutomaton* automaton,
+				const HangulInputContext* hic, int state, int k)
+{
+    HangulInputContext scratch;
+    HangulICOutput output;
+    HangulTransition* t;
+    bool res;
+    int next;
+    int commit = 0;
+
+    /* 조합 함수가 콜백을 부르지 않도록 한다. */
+    scratch = *hic;
+    scratch.callbacks = &hangul_ic_no_callbacks;
+    scratch.output = &output;
+    scratch.buffer = automaton->states[state];
+    output.owner = &scratch;
+    output.preedit_string[0] = 0;
+    output.commit_string[0] = 0;
+    output.preedit_len = 0;
+    output.commit_len = 0;
+
+    switch (automaton->type) {
+    case HANGUL_KEYBOARD_TYPE_JASO:
+    case HANGUL_KEYBOARD_TYPE_JASO_YET:
+	res = hangul_ic_process_jaso(&scratch, automaton->class_char[k]);
+	break;
+    case HANGUL_KEYBOARD_TYPE_ROMAJA:
+	res = hangul_ic_process_romaja(&scratch, automaton->class_ascii[k],
+				       automaton->class_char[k]);
+	break;
+    default:
+	res = hangul_ic_process_jamo(&scratch, automaton->class_char[k]);
+	break;
+    }
+
+    next = hangul_automaton_add_state(automaton, &scratch.buffer);
+    if (next < 0)
+	goto full;
+
+    if (output.commit_len > 0) {
+	commit = hangul_automaton_add_commit(automaton, output.commit_string,
+					     output.commit_len);
+	if (commit < 0)
+	    goto full;
+    }
+
+    if (!res)
+	commit |= HANGUL_TRANSITION_REJECT;
+    if (output.preedit_len == 0)
+	commit |= HANGUL_TRANSITION_NO_PREEDIT;
+
+    t = &automaton->table[state * automaton->nclasses + k];
+    t->next = next;
+    t->commit = commit;
+
+    return true;
+
+full:
+    hangul_automaton_clear(automaton);
+    return false;
+}
+
+/* 표에 현재 버퍼 상태를 등록하고 상태 번호를 기억한다. */
+static void
+hangul_ic_sync_automaton(HangulInputContext* hic)
+{
+    if (hic->automaton == NULL)
+	return;
+
+    hic->automaton_state = hangul_automaton_add_state(hic->automaton,
+						      &hic->buffer);
+    if (hic->automaton_state < 0) {
+	hangul_automaton_clear(hic->automaton);
+	hic->automaton_state = hangul_automaton_add_state(hic->automaton,
+							  &hic->buffer);
+    }
+    hic->automaton_generation = hic->automaton->generation;
+}
+
+static HangulAutomaton* hangul_ic_pool_get_automaton(HangulInputContextPool* pool,
+						     const HangulInputContext* hic);
+
+/* 현재 설정에 맞는 표를 찾는다. pool에서 만든 입력 상태는 pool이 가진
+ * 표를 같이 사용하고, 그렇지 않으면 입력 상태마다 표를 만든다. */
+static HangulAutomaton*
+hangul_ic_get_automaton(HangulInputContext* hic)
+{
+    HangulAutomaton* automaton = hic->automaton;
+
+    if (automaton != NULL && hangul_automaton_match(automaton, hic)) {
+	if (hic->automaton_generation != automaton->generation)
+	    hangul_ic_sync_automaton(hic);
+	return automaton;
+    }
+
+    hangul_automaton_delete(automaton);
+    if (hic->pool != NULL) {
+	automaton = hangul_ic_pool_get_automaton(hic->pool, hic);
+	if (automaton != NULL)
+	    automaton->ref_count++;
+    } else {
+	automaton = hangul_automaton_new(hic);
+    }
+
+    hic->automaton = automaton;
+    hangul_ic_sync_automaton(hic);
+    return automaton;
+}
+
+/* 표에서 키 하나의 전이를 찾아서 조합 상태를 옮긴다. 표로 처리할 수
+ * 없으면 상태를 바꾸지 않고 NULL을 리턴한다. */
+static const HangulTransition*
+hangul_ic_table_step(HangulInputContext* hic, int ascii)
+{
+    HangulAutomaton* automaton = hangul_ic_get_automaton(hic);
+    const HangulTransition* t;
+    int state;
+    int k;
+
+    if (automaton == NULL)
+	return NULL;
+
+    if (ascii < 0 || ascii >= N_ELEMENTS(automaton->key_class))
+	return NULL;
+
+    k = automaton->key_class[ascii];
+    state = hic->automaton_state;
+    if (k == 0 || state < 0)
+	return NULL;
+
+    t = &automaton->table[state * automaton->nclasses + k];
+    if (t->next == HANGUL_TRANSITION_UNKNOWN) {
+	if (!hangul_automaton_add_transition(automaton, hic, state, k))
+	    return NULL;
+	t = &automaton->table[state * automaton->nclasses + k];
+    }
+
+    hic->automaton_state = t->next;
+    hic->buffer = automaton->states[t->next];
+
+    return t;
+}
+
+/* 전이 t 에서 나온 commit 스트링, 없으면 길이가 0이다. */
+static inline const ucschar*
+hangul_automaton_get_commit(const HangulAutomaton* automaton,
+			    const HangulTransition* t, int* len)
+{
+    int commit = t->commit & HANGUL_TRANSITION_COMMIT_MASK;
+
+    *len = automaton->commit_offset[commit + 1] -
+	   automaton->commit_offset[commit];
+    return automaton->commit + automaton->commit_offset[commit];
+}
+
+/* 표로 키를 처리한다. 표로 처리할 수 없으면 -1을 리턴한다. */
+static int
+hangul_ic_process_table(HangulInputContext* hic, int ascii)
+{
+    const HangulTransition* t = hangul_ic_table_step(hic, ascii);
+    const HangulAutomaton* automaton = hic->automaton;
+    const ucschar* str;
+    int len;
+
+    if (t == NULL)
+	return -1;
+
+    str = hangul_automaton_get_commit(automaton, t, &len);
+    if (len > 0) {
+	if (hic->callbacks->on_commit != NULL) {
+	    hic->callbacks->on_commit(hic, str, len, hic->callbacks->on_commit_data);
+	} else {
+	    memcpy(hic->output->commit_string, str, len * sizeof(str[0]));
+	    hic->output->commit_string[len] = 0;
+	    hic->output->commit_len = len;
+	}
+    }
+
+    if (!(t->commit & HANGUL_TRANSITION_NO_PREEDIT)) {
+	str = automaton->preedit + automaton->preedit_offset[t->next];
+	len = automaton->preedit_offset[t->next + 1] -
+	      automaton->preedit_offset[t->next];
+
+	memcpy(hic->output->preedit_string, str, len * sizeof(str[0]));
+	hic->output->preedit_string[len] = 0;
+	hic->output->preedit_len = len;
+    }
+
+    return !(t->commit & HANGUL_TRANSITION_REJECT);
+}
+
+static int
+hangul_ic_trace_config(const HangulInputContext* hic)
+{
+    return hangul_ic_get_option_bits(hic) |
+	   (hic->option_transition_table << 3) |
+	   (hic->output_mode << 4) |
+	   (hic->use_jamo_mode_only << 5) |
+	   (hic->tableid << 8);
+}
+
+/* 이벤트를 처리하기 전에 부른다. 링의 절반을 새로 쓰기 시작하면
+ * 지금의 상태를 저장해 둔다. */
+static void
+hangul_ic_trace_begin(HangulInputContext* hic)
+{
+    HangulICTrace* trace = hic->trace;
+    int config = hangul_ic_trace_config(hic);
+
+    if (trace->keyboard != hic->keyboard || trace->config != config) {
+	trace->keyboard = hic->keyboard;
+	trace->config = config;
+	trace->head = 0;
+	trace->count = 0;
+    }
+
+    if (trace->head % HANGUL_IC_TRACE_HALF == 0) {
+	int i = trace->head / HANGUL_IC_TRACE_HALF;
+	trace->state_len[i] = hangul_ic_save_state(hic, trace->state[i],
+						   sizeof(trace->state[i]));
+    }
+}
+
+static void
+hangul_ic_trace_record(HangulInputContext* hic, int key, ucschar ch,
+		       bool result, int commit_len)
+{
+    HangulICTrace* trace = hic->trace;
+    HangulICTraceEntry* entry = &trace->entries[trace->head];
+
+    entry->key = key;
+    entry->ch = ch;
+    entry->choseong = hic->buffer.choseong;
+    entry->jungseong = hic->buffer.jungseong;
+    entry->jongseong = hic->buffer.jongseong;
+    entry->result = result;
+    entry->commit_len = commit_len;
+
+    trace->head = (trace->head + 1) % HANGUL_IC_TRACE_SIZE;
+    if (trace->count < HANGUL_IC_TRACE_SIZE)
+	trace->count++;
+}
+
+static bool
+hangul_ic_process_key(HangulInputContext *hic, int ascii, ucschar* ch)
+{
+    ucschar c;
+
+    hangul_ic_claim_output(hic);
+    hic->output->preedit_string[0] = 0;
+    hic->output->commit_string[0] = 0;
+    hic->output->preedit_len = 0;
+    hic->output->commit_len = 0;
+
+    /* 상태 전이표는 키 값을 직접 사용하므로 자판 배열을 찾기 전에
+     * 처리한다. */
+    if (hic->option_transition_table && ascii != '\b' &&
+	hic->callbacks->on_translate == NULL && hic->callbacks->on_transition == NULL) {
+	int res = hangul_ic_process_table(hic, ascii);
+	if (res >= 0)
+	    return res;
+    }
+
+    c = hangul_keyboard_map_to_char(hic->keyboard, hic->tableid, ascii);
+    if (hic->callbacks->on_translate != NULL)
+	hic->callbacks->on_translate(hic, ascii, &c, hic->callbacks->on_translate_data);
+
+    *ch = c;
+
+    if (ascii == '\b') {
+	return hangul_ic_backspace_internal(hic);
+    }
+
+    bool res;
+    int type = hangul_keyboard_get_type(hic->keyboard);
+    switch (type) {
+    case HANGUL_KEYBOARD_TYPE_JASO:
+    case HANGUL_KEYBOARD_TYPE_JASO_YET:
+	res = hangul_ic_process_jaso(hic, c);
+	break;
+    case HANGUL_KEYBOARD_TYPE_ROMAJA:
+	res = hangul_ic_process_romaja(hic, ascii, c);
+	break;
+    default:
+	res = hangul_ic_process_jamo(hic, c);
+	break;
+    }
+
+    hangul_ic_sync_automaton(hic);
+
+    return res;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 키 입력을 처리하여 실제로 한글 조합을 하는 함수
+ * @param hic @ref HangulInputContext 오브젝트
+ * @param ascii 키 이벤트
+ * @return @ref HangulInputContext 가 이 키를 사용했으면 true,
+ *	     사용하지 않았으면 false
+ *
+ * ascii 값으로 주어진 키 이벤트를 받아서 내부의 한글 조합 상태를
+ * 변화시키고, preedit, commit 스트링을 저장한다.
+ *
+ * libhangul의 키 이벤트 프로세스는 ASCII 코드 값을 기준으로 처리한다.
+ * 이 키 값은 US Qwerty 자판 배열에서의 키 값에 해당한다.
+ * 따라서 유럽어 자판을 사용하는 경우에는 해당 키의 ASCII 코드를 직접
+ * 전달하면 안되고, 그 키가 US Qwerty 자판이었을 경우에 발생할 수 있는 
+ * ASCII 코드 값을 주어야 한다.
+ * 또한 ASCII 코드 이므로 Shift 상태는 대문자로 전달이 된다.
+ * Capslock이 눌린 경우에는 대소문자를 뒤바꾸어 보내주지 않으면 
+ * 마치 Shift가 눌린 것 처럼 동작할 수 있으므로 주의한다.
+ * preedit, commit 스트링은 hangul_ic_get_preedit_string(),
+ * hangul_ic_get_commit_string() 함수를 이용하여 구할 수 있다.
+ * 
+ * 이 함수의 사용법에 대한 설명은 @ref hangulicusage 부분을 참조한다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+bool
+hangul_ic_process(HangulInputContext *hic, int ascii)
+{
+    ucschar c = 0;
+    bool res;
+
+    if (hic == NULL)
+	return false;
+
+    if (hic->trace == NULL)
+	return hangul_ic_process_key(hic, ascii, &c);
+
+    /* 표로 처리한 키는 자판의 글자를 찾지 않으므로 c 가 0으로 남는다.
+     * 그 글자는 hangul_ic_dump_trace() 에서 찾는다. */
+    hangul_ic_trace_begin(hic);
+    res = hangul_ic_process_key(hic, ascii, &c);
+    hangul_ic_trace_record(hic, ascii, c, res, hic->output->commit_len);
+
+    return res;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 키 입력을 처리하고 그 결과를 한번에 구하는 함수
+ * @param hic @ref HangulInputContext 오브젝트
+ * @param ascii 키 이벤트
+ * @param result 처리 결과를 저장할 @ref HangulICResult, NULL이어도 된다.
+ * @return @ref HangulInputContext 가 이 키를 사용했으면 true,
+ *	     사용하지 않았으면 false
+ *
+ * hangul_ic_process() 로 키를 처리하고 hangul_ic_get_commit_string_len(),
+ * hangul_ic_get_preedit_string_len(), hangul_ic_is_empty() 로 구할 수 있는
+ * 값을 @a result 에 한번에 채운다. 다른 언어의 바인딩에서 키 하나마다
+ * 여러번 함수를 부르는 부담을 줄이기 위해서 사용한다.
+ *
+ * @a result 의 flags 에는 다음 값이 설정된다.
+ *  - @ref HANGUL_IC_RESULT_CONSUMED: 이 키를 사용함, 리턴값과 같다.
+ *  - @ref HANGUL_IC_RESULT_COMMIT_CHANGED: commit 스트링이 비어 있지 않음
+ *  - @ref HANGUL_IC_RESULT_PREEDIT_CHANGED: preedit 스트링이 키를 처리하기
+ *    전과 달라짐
+ *  - @ref HANGUL_IC_RESULT_EMPTY: 처리한 후에 조합중인 글자가 없음
+ *
+ * preedit 스트링이 바뀐 내용은 preedit_prefix_len, preedit_removed,
+ * preedit_inserted 로도 알려준다. 키를 처리하기 전의 preedit 스트링에서
+ * 앞의 preedit_prefix_len 글자는 그대로 두고, 그 뒤의 preedit_removed
+ * 글자를 지운 다음 preedit_inserted 를 붙이면 새 preedit 스트링이 된다.
+ * 원격으로 preedit 스트링을 보내는 클라이언트는 스트링 전체 대신 바뀐
+ * 부분만 보낼 수 있다.
+ *
+ * @a result 의 commit, preedit 스트링은 @a hic 내부의 데이터이므로
+ * 수정하거나 free해서는 안되고, @a hic 나 같은 pool에서 만든 다른 입력
+ * 상태가 다음 키를 처리하면 그 내용이 바뀐다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+bool
+hangul_ic_process_ex(HangulInputContext *hic, int ascii,
+		     HangulICResult *result)
+{
+    ucschar preedit[N_ELEMENTS(hic->output->preedit_string)];
+    int preedit_len;
+    int prefix_len;
+    unsigned int flags = 0;
+    bool res;
+
+    if (hic == NULL) {
+	if (result != NULL)
+	    memset(result, 0, sizeof(*result));
+	return false;
+    }
+
+    if (result == NULL)
+	return hangul_ic_process(hic, ascii);
+
+    /* preedit 스트링이 바뀌었는지 알려면 처리하기 전의 것이 필요하다.
+     * 보통 한 음절이므로 복사하는 부담은 크지 않다. */
+    hangul_ic_claim_output(hic);
+    preedit_len = hic->output->preedit_len;
+    memcpy(preedit, hic->output->preedit_string,
+	   preedit_len * sizeof(preedit[0]));
+
+    res = hangul_ic_process(hic, ascii);
+
+    /* 콜백이 다른 입력 상태를 사용했을 수도 있다. */
+    hangul_ic_claim_output(hic);
+
+    if (res)
+	flags |= HANGUL_IC_RESULT_CONSUMED;
+    if (hic->output->commit_len > 0)
+	flags |= HANGUL_IC_RESULT_COMMIT_CHANGED;
+
+    prefix_len = 0;
+    while (prefix_len < preedit_len && prefix_len < hic->output->preedit_len &&
+	   preedit[prefix_len] == hic->output->preedit_string[prefix_len])
+	prefix_len++;
+
+    if (prefix_len != preedit_len || prefix_len != hic->output->preedit_len)
+	flags |= HANGUL_IC_RESULT_PREEDIT_CHANGED;
+    if (hangul_buffer_is_empty(&hic->buffer))
+	flags |= HANGUL_IC_RESULT_EMPTY;
+
+    result->flags = flags;
+    result->commit_len = hic->output->commit_len;
+    result->preedit_len = hic->output->preedit_len;
+    result->commit = hic->output->commit_string;
+    result->preedit = hic->output->preedit_string;
+    result->preedit_prefix_len = prefix_len;
+    result->preedit_removed = preedit_len - prefix_len;
+    result->preedit_inserted_len = hic->output->preedit_len - prefix_len;
+    result->preedit_inserted = hic->output->preedit_string + prefix_len;
+
+    return res;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 여러개의 키 입력을 한번에 처리하는 함수
+ * @param hic @ref HangulInputContext 오브젝트
+ * @param keys 처리할 키 입력들, ASCII 코드
+ * @param nkeys @a keys 의 길이
+ * @param out commit 스트링과 @a hic 가 사용하지 않은 키를 저장할 버퍼
+ * @param outcap @a out 버퍼의 크기, ucschar 단위
+ * @param outlen @a out 버퍼에 이미 들어 있는 글자의 수. 함수가 리턴할 때
+ *        새로 추가된 글자를 포함한 길이로 갱신된다.
+ * @return 처리한 키의 개수
+ *
+ * 이 함수는 @a keys 의 각 키에 대해서 hangul_ic_process() 를 부르고
+ * 그 결과로 나온 commit 스트링을 @a out 버퍼의 @a outlen 위치에 이어서
+ * 붙인다. hangul_ic_process() 가 사용하지 않은 키는 그 키의 ASCII 값을
+ * 그대로 붙인다. 많은 양의 텍스트를 변환할 때 키마다 함수를 불러 commit
+ * 스트링을 확인하는 부담을 줄이기 위해서 사용한다.
+ *
+ * 다음의 경우에는 남은 키를 처리하지 않고 리턴한다. 리턴값으로 어디까지
+ * 처리했는지 확인하고 나머지는 다시 처리해야 한다.
+ *  - @a out 버퍼에 키 하나를 처리한 결과를 담을 공간이 남지 않은 경우
+ *  - ASCII 범위를 벗어난 키를 만난 경우. 이 키는 ucschar로 그대로
+ *    옮길 수 없으므로 호출한 쪽에서 처리해야 한다.
+ *
+ * 조합중인 글자는 @a out 에 들어가지 않는다. 입력이 끝나면 hangul_ic_flush()
+ * 함수로 마지막 글자를 받아야 한다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+int
+hangul_ic_process_keys(HangulInputContext *hic, const char *keys, int nkeys,
+		       ucschar *out, int outcap, int *outlen)
+{
+    int i;
+    int len;
+
+    if (hic == NULL || keys == NULL || out == NULL || outlen == NULL)
+	return 0;
+
+    len = *outlen;
+    for (i = 0; i < nkeys; i++) {
+	int ascii = (unsigned char)keys[i];
+	bool res;
+
+	if (ascii >= 0x80)
+	    break;
+
+	/* 키 하나를 처리하면 commit 스트링 버퍼를 가득 채우는 만큼과
+	 * 사용하지 않은 키 하나가 나올 수 있다. */
+	if (outcap - len < (int)N_ELEMENTS(hic->output->commit_string))
+	    break;
+
+	res = hangul_ic_process(hic, ascii);
+	memcpy(out + len, hic->output->commit_string,
+	       hic->output->commit_len * sizeof(hic->output->commit_string[0]));
+	len += hic->output->commit_len;
+	if (!res)
+	    out[len++] = ascii;
+    }
+
+    *outlen = len;
+
+    return i;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 여러 입력 상태의 키 입력을 한번에 처리하는 함수
+ * @param hics 키를 처리할 @ref HangulInputContext 의 배열
+ * @param keys @a hics 의 각 입력 상태에 줄 키 입력, ASCII 코드
+ * @param n 처리할 키 입력의 개수
+ * @param results 각 키를 사용했는지 여부를 저장할 배열, NULL이어도 된다.
+ * @param out 각 키를 처리한 결과로 나온 commit 스트링을 저장할 버퍼
+ * @param outcap @a out 버퍼의 크기, ucschar 단위
+ * @param offsets 각 키의 commit 스트링의 위치를 저장할 배열,
+ *        n + 1 개가 필요하다. i번째 키의 commit 스트링은 @a out 에서
+ *        offsets[i] 부터 offsets[i + 1] 앞까지이다.
+ * @return 처리한 키의 개수
+ *
+ * 서버와 같이 많은 세션의 키 입력을 모아서 처리하는 경우에 사용한다.
+ * i번째 키를 hics[i] 에 hangul_ic_process() 로 처리한 것과 결과가 같고,
+ * 배열의 순서대로 처리하므로 같은 입력 상태가 여러번 나와도 된다.
+ * hics[i] 가 NULL 이면 그 키는 사용하지 않은 것으로 처리한다.
+ *
+ * @ref HANGUL_IC_OPTION_TRANSITION_TABLE 옵션을 켜고 콜백을 연결하지 않은
+ * 입력 상태는 표에서 바로 다음 상태를 찾고 commit 스트링을 @a out 에
+ * 직접 복사한다. preedit 스트링은 키마다 만들지 않고
+ * hangul_ic_get_preedit_string() 으로 구할 때 만든다.
+ * 따라서 이 함수를 부른 후에는 commit 스트링을 @a out 에서 읽어야 하고,
+ * hangul_ic_get_commit_string() 은 빈 스트링을 리턴할 수 있다.
+ * 같은 자판과 옵션을 사용하는 입력 상태를 pool에서 만들면 표를 공유하므로
+ * 많은 세션을 처리할 때에도 표가 캐시에 남아 있게 된다.
+ *
+ * @a out 버퍼에 키 하나를 처리한 결과를 담을 공간이 남지 않으면 남은
+ * 키를 처리하지 않고 리턴한다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+int
+hangul_ic_process_batch(HangulInputContext **hics, const int *keys, int n,
+			bool *results, ucschar *out, int outcap, int *offsets)
+{
+    int len = 0;
+    int i;
+
+    if (hics == NULL || keys == NULL || out == NULL || offsets == NULL)
+	return 0;
+
+    for (i = 0; i < n; i++) {
+	HangulInputContext* hic = hics[i];
+	int ascii = keys[i];
+	const HangulTransition* t = NULL;
+	bool res;
+
+	/* hangul_ic_process() 와 같이 키를 사용하지 않은 것으로 한다. */
+	if (hic == NULL) {
+	    offsets[i] = len;
+	    if (results != NULL)
+		results[i] = false;
+	    continue;
+	}
+
+	/* 키 하나를 처리하면 commit 스트링 버퍼를 가득 채우는 만큼이
+	 * 나올 수 있다. */
+	if (outcap - len < (int)N_ELEMENTS(hic->output->commit_string))
+	    break;
+
+	offsets[i] = len;
+
+	if (hic->option_transition_table && ascii != '\b' &&
+	    hic->callbacks == &hangul_ic_no_callbacks && hic->trace == NULL)
+	    t = hangul_ic_table_step(hic, ascii);
+
+	if (t != NULL) {
+	    const ucschar* str;
+	    int commit_len;
+
+	    str = hangul_automaton_get_commit(hic->automaton, t, &commit_len);
+	    if (commit_len > 0)
+		memcpy(out + len, str, commit_len * sizeof(str[0]));
+	    len += commit_len;
+	    res = !(t->commit & HANGUL_TRANSITION_REJECT);
+
+	    /* 결과 스트링 버퍼는 이전 키의 것이므로 다음에 사용할 때
+	     * 다시 만들도록 한다. */
+	    if (hic->output->owner == hic)
+		hic->output->owner = NULL;
+	} else {
+	    res = hangul_ic_process(hic, ascii);
+	    memcpy(out + len, hic->output->commit_string,
+		   hic->output->commit_len * sizeof(out[0]));
+	    len += hic->output->commit_len;
+	}
+
+	if (results != NULL)
+	    results[i] = res;
+    }
+
+    offsets[i] = len;
+
+    return i;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 현재 상태의 preedit string을 구하는 함수
+ * @param hic preedit string을 구하고자하는 입력 상태 object
+ * @return UCS4 preedit 스트링, 이 스트링은 @a hic 내부의 데이터이므로 
+ *         수정하거나 free해서는 안된다.
+ * 
+ * 이 함수는  @a hic 내부의 현재 상태의 preedit string을 리턴한다.
+ * 따라서 hic가 다른 키 이벤트를 처리하고 나면 그 내용이 바뀔 수 있다.
+ * 
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
+ */
+const ucschar*
+hangul_ic_get_preedit_string(HangulInputContext *hic)
+{
+    if (hic == NULL)
+	return NULL;
+
+    hangul_ic_claim_output(hic);
+
+    return hic->output->preedit_string;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 현재 상태의 commit string을 구하는 함수
+ * @param hic commit string을 구하고자하는 입력 상태 object
+ * @return UCS4 commit 스트링, 이 스트링은 @a hic 내부의 데이터이므로 
+ *         수정하거나 free해서는 안된다.
+ * 
+ * 이 함수는  @a hic 내부의 현재 상태의 commit string을 리턴한다.
+ * 따라서 hic가 다른 키 이벤트를 처리하고 나면 그 내용이 바뀔 수 있다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
+ */
+const ucschar*
+hangul_ic_get_commit_string(HangulInputContext *hic)
+{
+    if (hic == NULL)
+	return NULL;
+
+    hangul_ic_claim_output(hic);
+
+    return hic->output->commit_string;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 현재 상태의 preedit string과 그 길이를 구하는 함수
+ * @param hic preedit string을 구하고자하는 입력 상태 object
+ * @param len preedit string의 길이를 저장할 포인터, ucschar 단위.
+ *        NULL이어도 된다.
+ * @return UCS4 preedit 스트링, hangul_ic_get_preedit_string() 과 같다.
+ *
+ * @a hic 는 스트링의 길이를 기억하고 있으므로 0을 찾아 스트링을 읽어볼
+ * 필요 없이 길이를 알 수 있다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
+ */
+const ucschar*
+hangul_ic_get_preedit_string_len(HangulInputContext *hic, int *len)
+{
+    if (hic == NULL) {
+	if (len != NULL)
+	    *len = 0;
+	return NULL;
+    }
+
+    hangul_ic_claim_output(hic);
+
+    if (len != NULL)
+	*len = hic->output->preedit_len;
+
+    return hic->output->preedit_string;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 현재 상태의 commit string과 그 길이를 구하는 함수
+ * @param hic commit string을 구하고자하는 입력 상태 object
+ * @param len commit string의 길이를 저장할 포인터, ucschar 단위.
+ *        NULL이어도 된다.
+ * @return UCS4 commit 스트링, hangul_ic_get_commit_string() 과 같다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
+ */
+const ucschar*
+hangul_ic_get_commit_string_len(HangulInputContext *hic, int *len)
+{
+    if (hic == NULL) {
+	if (len != NULL)
+	    *len = 0;
+	return NULL;
+    }
+
+    hangul_ic_claim_output(hic);
+
+    if (len != NULL)
+	*len = hic->output->commit_len;
+
+    return hic->output->commit_string;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 현재 상태의 preedit string을 UTF-8로 구하는 함수
+ * @param hic preedit string을 구하고자하는 입력 상태 object
+ * @param buf UTF-8 스트링을 저장할 버퍼
+ * @param buflen @a buf 의 크기, 바이트 단위
+ * @return @a buf 에 저장한 바이트 수, 끝의 0은 포함하지 않는다.
+ *
+ * hangul_ic_get_preedit_string() 의 결과를 iconv 없이 UTF-8로 변환하여
+ * @a buf 에 0으로 끝나는 스트링으로 저장한다. preedit string은
+ * 한 음절이므로 32 바이트 정도의 버퍼면 충분하다.
+ * 버퍼가 부족하면 들어갈 수 있는 글자까지만 저장한다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
+ */
+int
+hangul_ic_get_preedit_string_utf8(HangulInputContext *hic,
+				  char *buf, int buflen)
+{
+    if (hic == NULL || buf == NULL || buflen <= 0)
+	return 0;
+
+    hangul_ic_claim_output(hic);
+    return hangul_ucs4_to_utf8(buf, buflen, hic->output->preedit_string,
+			       hic->output->preedit_len);
+}
+
+/**
+ * @ingroup hangulic
+ * @brief 현재 상태의 commit string을 UTF-8로 구하는 함수
+ * @param hic commit string을 구하고자하는 입력 상태 object
+ * @param buf UTF-8 스트링을 저장할 버퍼
+ * @param buflen @a buf 의 크기, 바이트 단위
+ * @return @a buf 에 저장한 바이트 수, 끝의 0은 포함하지 않는다.
+ *
+ * hangul_ic_get_commit_string() 의 결과를 iconv 없이 UTF-8로 변환하여
+ * @a buf 에 0으로 끝나는 스트링으로 저장한다.
+ * 버퍼가 부족하면 들어갈 수 있는 글자까지만 저장한다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
+ */
+int
+hangul_ic_get_commit_string_utf8(HangulInputContext *hic,
+				 char *buf, int buflen)
+{
+    if (hic == NULL || buf == NULL || buflen <= 0)
+	return 0;
+
+    hangul_ic_claim_output(hic);
+    return hangul_ucs4_to_utf8(buf, buflen, hic->output->commit_string,
+			       hic->output->commit_len);
+}
+
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 를 초기상태로 되돌리는 함수
+ * @param hic @ref HangulInputContext 를 가리키는 포인터
+ * 
+ * 이 함수는 @a hic가 가리키는 @ref HangulInputContext 의 상태를 
+ * 처음 상태로 되돌린다. preedit 스트링, commit 스트링, flush 스트링이
+ * 없어지고, 입력되었던 키에 대한 기록이 없어진다.
+ * 영어 상태로 바뀌는 것이 아니다.
+ *
+ * 비교: hangul_ic_flush()
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+void
+hangul_ic_reset(HangulInputContext *hic)
+{
+    if (hic == NULL)
+	return;
+
+    if (hic->trace != NULL)
+	hangul_ic_trace_begin(hic);
+
+    hic->output->owner = hic;
+    hangul_ic_output_clear(hic->output);
+
+    hangul_buffer_clear(&hic->buffer);
+    hic->automaton_state = 0;
+
+    if (hic->trace != NULL)
+	hangul_ic_trace_record(hic, HANGUL_IC_TRACE_RESET, 0, true, 0);
+}
+
+/* append current preedit to the commit buffer.
+ * this function does not clear previously made commit string. */
+static void
+hangul_ic_flush_internal(HangulInputContext *hic)
+{
+    hic->output->preedit_string[0] = 0;
+    hic->output->preedit_len = 0;
+
+    hangul_ic_save_commit_string(hic);
+    hangul_buffer_clear(&hic->buffer);
+}
+
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 의 입력 상태를 완료하는 함수
+ * @param hic @ref HangulInputContext 를 가리키는 포인터
+ * @return 조합 완료된 스트링, 스트링의 길이가 0이면 조합 완료된 스트링이 
+ *	  없는 것
+ *
+ * 이 함수는 @a hic가 가리키는 @ref HangulInputContext 의 입력 상태를 완료한다.
+ * 조합중이던 스트링을 완성하여 리턴한다. 그리고 입력 상태가 초기 상태로 
+ * 되돌아 간다. 조합중이던 글자를 강제로 commit하고 싶을때 사용하는 함수다.
+ * 보통의 경우 입력 framework에서 focus가 나갈때 이 함수를 불러서 마지막 
+ * 상태를 완료해야 조합중이던 글자를 잃어버리지 않게 된다.
+ *
+ * 비교: hangul_ic_reset()
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+const ucschar*
+hangul_ic_flush(HangulInputContext *hic)
+{
+    if (hic == NULL)
+	return NULL;
+
+    if (hic->trace != NULL)
+	hangul_ic_trace_begin(hic);
+
+    // get the remaining string and clear the buffer
+    hic->output->owner = hic;
+    hangul_ic_output_clear(hic->output);
+
+    if (hic->output_mode == HANGUL_OUTPUT_JAMO) {
+	hic->output->flushed_len =
+	    hangul_buffer_get_jamo_string(&hic->buffer, hic->output->flushed_string,
+					  N_ELEMENTS(hic->output->flushed_string));
+    } else {
+	hic->output->flushed_len =
+	    hangul_buffer_get_string(&hic->buffer, hic->output->flushed_string,
+				     N_ELEMENTS(hic->output->flushed_string));
+    }
+
+    hangul_buffer_clear(&hic->buffer);
+    hic->automaton_state = 0;
+
+    if (hic->trace != NULL)
+	hangul_ic_trace_record(hic, HANGUL_IC_TRACE_FLUSH, 0, true,
+			       hic->output->flushed_len);
+
+    return hic->output->flushed_string;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 의 입력 상태를 완료하고 그 길이를 구하는 함수
+ * @param hic @ref HangulInputContext 를 가리키는 포인터
+ * @param len 조합 완료된 스트링의 길이를 저장할 포인터, ucschar 단위.
+ *        NULL이어도 된다.
+ * @return 조합 완료된 스트링
+ *
+ * hangul_ic_flush() 와 같고, 리턴하는 스트링의 길이를 @a len 에 저장한다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+const ucschar*
+hangul_ic_flush_len(HangulInputContext *hic, int *len)
+{
+    const ucschar* str = hangul_ic_flush(hic);
+
+    if (len != NULL)
+	*len = hic != NULL ? hic->output->flushed_len : 0;
+
+    return str;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 가 backspace 키를 처리하도록 하는 함수
+ * @param hic @ref HangulInputContext 를 가리키는 포인터
+ * @return @a hic가 키를 사용했으면 true, 사용하지 않았으면 false
+ * 
+ * 이 함수는 @a hic가 가리키는 @ref HangulInputContext 의 조합중이던 글자를
+ * 뒤에서부터 하나 지우는 기능을 한다. backspace 키를 눌렀을 때 발생하는 
+ * 동작을 한다. 따라서 이 함수를 부르고 나면 preedit string이 바뀌므로
+ * 반드시 업데이트를 해야 한다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+bool
+hangul_ic_backspace(HangulInputContext *hic)
+{
+    bool ret;
+
+    if (hic == NULL)
+	return false;
+
+    if (hic->trace == NULL)
+	return hangul_ic_backspace_internal(hic);
+
+    hangul_ic_trace_begin(hic);
+    ret = hangul_ic_backspace_internal(hic);
+    hangul_ic_trace_record(hic, '\b', 0, ret, 0);
+
+    return ret;
+}
+
+static bool
+hangul_ic_backspace_internal(HangulInputContext *hic)
+{
+    int ret;
+
+    hangul_ic_claim_output(hic);
+    hic->output->preedit_string[0] = 0;
+    hic->output->commit_string[0] = 0;
+    hic->output->preedit_len = 0;
+    hic->output->commit_len = 0;
+
+    ret = hangul_buffer_backspace(&hic->buffer);
+    if (ret)
+	hangul_ic_save_preedit_string(hic);
+
+    hangul_ic_sync_automaton(hic);
+    return ret;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 가 조합중인 글자를 가지고 있는지 확인하는 함수
+ * @param hic @ref HangulInputContext 를 가리키는 포인터
+ *
+ * @ref HangulInputContext 가 조합중인 글자가 있으면 true를 리턴한다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
+ */
+bool
+hangul_ic_is_empty(HangulInputContext *hic)
+{
+    return hangul_buffer_is_empty(&hic->buffer);
+}
+
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 가 조합중인 초성을 가지고 있는지 확인하는 함수
+ * @param hic @ref HangulInputContext 를 가리키는 포인터
+ *
  * @ref HangulInputContext 가 조합중인 글자가 초성이 있으면 true를 리턴한다.
  *
  * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
@@ -1334,6 +2575,10 @@ hangul_ic_get_option(HangulInputContext* hic, int option)
 	return hic->option_combi_on_double_stroke;
     case HANGUL_IC_OPTION_NON_CHOSEONG_COMBI:
 	return hic->option_non_choseong_combi;
+    case HANGUL_IC_OPTION_TRANSITION_TABLE:
+	return hic->option_transition_table;
+    case HANGUL_IC_OPTION_TRACE:
+	return hic->trace != NULL;
     }
 
     return false;
@@ -1359,6 +2604,16 @@ hangul_ic_get_option(HangulInputContext* hic, int option)
  *        두벌식 자판 이외에는 옵션이 동작하지 않는다.
  *        MS IME와 호환을 위해서 사용.
  *        예) true면 ㄱ+ㅅ -> ㄳ 으로 조합시켜 줌.
+ *    - HANGUL_IC_OPTION_TRANSITION_TABLE
+ *      - 한번 계산한 조합 결과를 상태 전이표에 기록해 두고 같은 상태에서
+ *        같은 키가 입력되면 표를 읽어서 처리하는 옵션.
+ *        조합 결과는 바뀌지 않고, 많은 입력을 한번에 변환할 때 빨라진다.
+ *        translate, transition 콜백을 사용하는 경우에는 동작하지 않는다.
+ *        표를 위해 메모리를 더 사용하므로 기본값은 false이다.
+ *    - HANGUL_IC_OPTION_TRACE
+ *      - 최근의 키 입력과 그 처리 결과를 기록하는 옵션.
+ *        잘못 조합되는 경우를 재현하기 위해 사용한다. 기록한 내용은
+ *        hangul_ic_dump_trace() 로 구한다. 기본값은 false이다.
  * @param value 설정하고자 하는 값, true 또는 false
  */
 void
@@ -1374,6 +2629,21 @@ hangul_ic_set_option(HangulInputContext* hic, int option, bool value)
     case HANGUL_IC_OPTION_NON_CHOSEONG_COMBI:
 	hic->option_non_choseong_combi = value;
 	break;
+    case HANGUL_IC_OPTION_TRANSITION_TABLE:
+	hic->option_transition_table = value;
+	if (!value) {
+	    hangul_automaton_delete(hic->automaton);
+	    hic->automaton = NULL;
+	}
+	break;
+    case HANGUL_IC_OPTION_TRACE:
+	if (value && hic->trace == NULL) {
+	    hic->trace = calloc(1, sizeof(HangulICTrace));
+	} else if (!value) {
+	    free(hic->trace);
+	    hic->trace = NULL;
+	}
+	break;
     }
 }
 
@@ -1384,7 +2654,26 @@ hangul_ic_set_output_mode(HangulInputContext *hic, int mode)
 	return;
 
     if (!hic->use_jamo_mode_only)
-	hic->output_mode = mode;
+	hic->output_mode = mode == HANGUL_OUTPUT_JAMO ?
+			   HANGUL_OUTPUT_JAMO : HANGUL_OUTPUT_SYLLABLE;
+}
+
+/* 콜백을 처음 연결할 때 콜백 구조체를 할당한다. */
+static HangulICCallbacks*
+hangul_ic_get_callbacks(HangulInputContext* hic)
+{
+    HangulICCallbacks* callbacks;
+
+    if (hic->callbacks != &hangul_ic_no_callbacks)
+	return (HangulICCallbacks*)hic->callbacks;
+
+    callbacks = malloc(sizeof(HangulICCallbacks));
+    if (callbacks == NULL)
+	return NULL;
+
+    *callbacks = hangul_ic_no_callbacks;
+    hic->callbacks = callbacks;
+    return callbacks;
 }
 
 void
@@ -1392,9 +2681,15 @@ hangul_ic_connect_translate (HangulInputContext* hic,
                              HangulOnTranslate callback,
                              void* user_data)
 {
-    if (hic != NULL) {
-	hic->on_translate      = callback;
-	hic->on_translate_data = user_data;
+    HangulICCallbacks* callbacks;
+
+    if (hic == NULL)
+	return;
+
+    callbacks = hangul_ic_get_callbacks(hic);
+    if (callbacks != NULL) {
+	callbacks->on_translate      = callback;
+	callbacks->on_translate_data = user_data;
     }
 }
 
@@ -1403,24 +2698,63 @@ hangul_ic_connect_transition(HangulInputContext* hic,
                              HangulOnTransition callback,
                              void* user_data)
 {
-    if (hic != NULL) {
-	hic->on_transition      = callback;
-	hic->on_transition_data = user_data;
+    HangulICCallbacks* callbacks;
+
+    if (hic == NULL)
+	return;
+
+    callbacks = hangul_ic_get_callbacks(hic);
+    if (callbacks != NULL) {
+	callbacks->on_transition      = callback;
+	callbacks->on_transition_data = user_data;
     }
 }
 
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 에 콜백 함수를 연결하는 함수
+ * @param hic @ref HangulInputContext 오브젝트
+ * @param event 콜백을 연결할 이벤트 이름
+ *   @li "translate"  키 입력을 글자로 바꾼 후에 불린다.
+ *   @li "transition" 조합 상태가 바뀌기 전에 불린다.
+ *   @li "commit"     조합이 완료된 글자가 생길 때마다 불린다.
+ * @param callback 연결할 함수, NULL이면 연결을 끊는다.
+ * @param user_data 콜백 함수의 마지막 인자로 전달할 데이터
+ *
+ * "commit" 콜백은 다음과 같은 형식이다.
+ * @code
+ * void on_commit(HangulInputContext* hic, const ucschar* str, int len,
+ *                void* user_data);
+ * @endcode
+ * @a str 은 0으로 끝나지 않을 수 있으므로 @a len 을 사용해야 한다.
+ * 키 하나를 처리하는 동안 여러번 불릴 수 있고, 불린 순서대로 이어 붙이면
+ * 완료된 스트링이 된다.
+ * 이 콜백이 연결되어 있으면 완료된 글자는 내부 버퍼에 저장하지 않으므로
+ * hangul_ic_get_commit_string() 은 빈 스트링을 리턴하고, 길이 제한으로
+ * 글자가 잘리는 일도 없다. hangul_ic_flush() 는 콜백을 부르지 않고
+ * 이전과 같이 남은 스트링을 리턴한다.
+ */
 void hangul_ic_connect_callback(HangulInputContext* hic, const char* event,
 				void* callback, void* user_data)
 {
+    HangulICCallbacks* callbacks;
+
     if (hic == NULL || event == NULL)
 	return;
 
+    callbacks = hangul_ic_get_callbacks(hic);
+    if (callbacks == NULL)
+	return;
+
     if (strcasecmp(event, "translate") == 0) {
-        *(void**)(&hic->on_translate) = callback;
-	hic->on_translate_data = user_data;
+        *(void**)(&callbacks->on_translate) = callback;
+	callbacks->on_translate_data = user_data;
     } else if (strcasecmp(event, "transition") == 0) {
-        *(void**)(&hic->on_transition) = callback;
-	hic->on_transition_data = user_data;
+        *(void**)(&callbacks->on_transition) = callback;
+	callbacks->on_transition_data = user_data;
+    } else if (strcasecmp(event, "commit") == 0) {
+        *(void**)(&callbacks->on_commit) = callback;
+	callbacks->on_commit_data = user_data;
     }
 }
 
@@ -1463,6 +2797,10 @@ hangul_ic_switch_keyboard_table(HangulInputContext *hic, int tableid)
  * 
  * 이 함수는 @ref HangulInputContext 의 자판을 @a id로 지정된 것으로 변경한다.
  * 
+ * @a id 는 hangul_keyboard_list_get_keyboard() 로 찾는다. 같은 자판으로
+ * 여러번 바꾼다면 그 함수로 구한 자판을 hangul_ic_set_keyboard() 로 바로
+ * 설정하는 것이 더 빠르다.
+ *
  * @remarks 이 함수는 @ref HangulInputContext 의 내부 조합 상태에는 영향을
  * 미치지 않는다.  따라서 입력 중간에 자판을 변경하더라도 조합 상태는 유지된다.
  */
@@ -1487,6 +2825,88 @@ hangul_ic_set_combination(HangulInputContext *hic,
 {
 }
 
+/* pool을 사용하지 않는 입력 상태는 결과 스트링 버퍼를 바로 뒤에 붙여서
+ * 한번에 할당한다. */
+typedef struct _HangulICStandalone {
+    HangulInputContext hic;
+    HangulICOutput output;
+} HangulICStandalone;
+
+/* pool은 입력 상태를 HANGUL_IC_POOL_SLAB_SIZE 개씩 한번에 할당한다.
+ * 사용하지 않는 항목은 free_list 로 연결해 둔다. */
+#define HANGUL_IC_POOL_SLAB_SIZE 256
+
+/* 상태 전이표 하나가 수백 KB 를 사용하므로 pool 이 가지고 있는 표의 수를
+ * 제한한다. 자판과 옵션의 조합이 이보다 많으면 가장 오래 사용하지 않은
+ * 표부터 뺀다. */
+#define HANGUL_IC_POOL_MAX_AUTOMATA 8
+
+typedef union _HangulICPoolItem {
+    HangulInputContext hic;
+    union _HangulICPoolItem* next;
+} HangulICPoolItem;
+
+typedef struct _HangulICPoolSlab {
+    struct _HangulICPoolSlab* next;
+    HangulICPoolItem items[HANGUL_IC_POOL_SLAB_SIZE];
+} HangulICPoolSlab;
+
+struct _HangulInputContextPool {
+    HangulICOutput output;
+    HangulICPoolSlab* slabs;
+    HangulICPoolItem* free_list;
+
+    /* 최근에 사용한 순서로 정렬되어 있다. */
+    HangulAutomaton* automata[HANGUL_IC_POOL_MAX_AUTOMATA];
+    int nautomata;
+};
+
+static void hangul_ic_pool_release(HangulInputContextPool* pool,
+				   HangulInputContext* hic);
+
+static void
+hangul_ic_output_clear(HangulICOutput* output)
+{
+    output->preedit_string[0] = 0;
+    output->commit_string[0] = 0;
+    output->flushed_string[0] = 0;
+    output->preedit_len = 0;
+    output->commit_len = 0;
+    output->flushed_len = 0;
+}
+
+static void
+hangul_ic_init(HangulInputContext* hic, HangulICOutput* output,
+	       HangulInputContextPool* pool, const char* keyboard)
+{
+    hic->keyboard = NULL;
+    hic->tableid = 0;
+
+    hic->output = output;
+    hic->callbacks = &hangul_ic_no_callbacks;
+    hic->pool = pool;
+    hic->trace = NULL;
+
+    hic->automaton = NULL;
+    hic->automaton_state = -1;
+    hic->automaton_generation = 0;
+
+    hic->use_jamo_mode_only = FALSE;
+
+    hic->option_auto_reorder = false;
+    hic->option_combi_on_double_stroke = false;
+    hic->option_non_choseong_combi = true;
+    hic->option_transition_table = false;
+
+    hangul_ic_set_output_mode(hic, HANGUL_OUTPUT_SYLLABLE);
+    hangul_ic_select_keyboard(hic, keyboard);
+
+    hangul_buffer_clear(&hic->buffer);
+
+    output->owner = hic;
+    hangul_ic_output_clear(output);
+}
+
 /**
  * @ingroup hangulic
  * @brief @ref HangulInputContext 오브젝트를 생성한다.
@@ -1502,37 +2922,15 @@ hangul_ic_set_combination(HangulInputContext *hic,
 HangulInputContext*
 hangul_ic_new(const char* keyboard)
 {
-    HangulInputContext *hic;
+    HangulICStandalone* standalone;
 
-    hic = malloc(sizeof(HangulInputContext));
-    if (hic == NULL)
+    standalone = malloc(sizeof(HangulICStandalone));
+    if (standalone == NULL)
 	return NULL;
 
-    hic->keyboard = NULL;
-    hic->tableid = 0;
-
-    hic->preedit_string[0] = 0;
-    hic->commit_string[0] = 0;
-    hic->flushed_string[0] = 0;
-
-    hic->on_translate      = NULL;
-    hic->on_translate_data = NULL;
-
-    hic->on_transition      = NULL;
-    hic->on_transition_data = NULL;
-
-    hic->use_jamo_mode_only = FALSE;
-
-    hic->option_auto_reorder = false;
-    hic->option_combi_on_double_stroke = false;
-    hic->option_non_choseong_combi = true;
-
-    hangul_ic_set_output_mode(hic, HANGUL_OUTPUT_SYLLABLE);
-    hangul_ic_select_keyboard(hic, keyboard);
-
-    hangul_buffer_clear(&hic->buffer);
+    hangul_ic_init(&standalone->hic, &standalone->output, NULL, keyboard);
 
-    return hic;
+    return &standalone->hic;
 }
 
 /**
@@ -1552,9 +2950,608 @@ hangul_ic_delete(HangulInputContext *hic)
     if (hic == NULL)
 	return;
 
+    if (hic->callbacks != &hangul_ic_no_callbacks)
+	free((HangulICCallbacks*)hic->callbacks);
+
+    free(hic->trace);
+
+    hangul_automaton_delete(hic->automaton);
+
+    if (hic->pool != NULL) {
+	hangul_ic_pool_release(hic->pool, hic);
+	return;
+    }
+
     free(hic);
 }
 
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 를 할당할 pool을 생성한다.
+ * @return 새로 생성된 pool에 대한 포인터
+ *
+ * 서버처럼 많은 수의 입력 상태를 동시에 유지해야 하는 경우에 사용한다.
+ * hangul_ic_new_from_pool() 로 만든 입력 상태는 다음과 같은 점이
+ * hangul_ic_new() 로 만든 것과 다르다.
+ *  - 조합 상태만 가지므로 크기가 훨씬 작고, 여러개를 한 덩어리로
+ *    할당하였다가 hangul_ic_delete() 하면 pool에 돌려주므로 malloc 호출이
+ *    거의 없다.
+ *  - preedit, commit, flush 스트링 버퍼를 pool 전체가 공유한다.
+ *    preedit 스트링은 언제 구해도 그 입력 상태의 것을 돌려주지만,
+ *    commit 스트링과 flush 스트링은 같은 pool의 다른 입력 상태를 사용하기
+ *    전에 읽어야 한다.
+ *  - @ref HANGUL_IC_OPTION_TRANSITION_TABLE 옵션의 상태 전이표는 같은
+ *    자판과 옵션을 사용하는 입력 상태끼리 공유한다. pool 은 최근에 사용한
+ *    표를 8개까지 가지고 있고, 자판이 삭제되거나 바뀌면 그 자판의 표를
+ *    버린다.
+ *
+ * 같은 pool에서 만든 입력 상태들은 한 스레드에서만 사용해야 한다.
+ * 여러 스레드에서 사용할 때에는 스레드마다 pool을 만든다.
+ * 더이상 사용하지 않을 때에는 hangul_ic_pool_delete() 로 삭제한다.
+ */
+HangulInputContextPool*
+hangul_ic_pool_new(void)
+{
+    HangulInputContextPool* pool;
+
+    pool = malloc(sizeof(HangulInputContextPool));
+    if (pool == NULL)
+	return NULL;
+
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->nautomata = 0;
+
+    pool->output.owner = NULL;
+    hangul_ic_output_clear(&pool->output);
+
+    return pool;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief pool을 삭제하는 함수
+ * @param pool 삭제할 pool
+ *
+ * @a pool 에서 할당한 모든 메모리를 해제한다. @a pool 에서 만든 입력
+ * 상태는 이 함수를 부르기 전에 hangul_ic_delete() 로 삭제해야 한다.
+ */
+void
+hangul_ic_pool_delete(HangulInputContextPool* pool)
+{
+    HangulICPoolSlab* slab;
+    int i;
+
+    if (pool == NULL)
+	return;
+
+    slab = pool->slabs;
+    while (slab != NULL) {
+	HangulICPoolSlab* next = slab->next;
+	free(slab);
+	slab = next;
+    }
+
+    for (i = 0; i < pool->nautomata; i++)
+	hangul_automaton_delete(pool->automata[i]);
+
+    free(pool);
+}
+
+/**
+ * @ingroup hangulic
+ * @brief pool에서 @ref HangulInputContext 를 할당하는 함수
+ * @param pool 입력 상태를 할당할 pool
+ * @param keyboard 사용하고자 하는 키보드, hangul_ic_new() 와 같다.
+ * @return 새로 생성된 @ref HangulInputContext 에 대한 포인터
+ *
+ * hangul_ic_new() 와 같이 동작하는 입력 상태를 @a pool 에서 할당한다.
+ * 다른 점은 hangul_ic_pool_new() 의 설명을 참조한다.
+ * 더이상 사용하지 않을 때에는 hangul_ic_delete() 로 삭제하면 @a pool 에
+ * 돌려준다.
+ */
+HangulInputContext*
+hangul_ic_new_from_pool(HangulInputContextPool* pool, const char* keyboard)
+{
+    HangulICPoolItem* item;
+
+    if (pool == NULL)
+	return NULL;
+
+    if (pool->free_list == NULL) {
+	HangulICPoolSlab* slab;
+	int i;
+
+	slab = malloc(sizeof(HangulICPoolSlab));
+	if (slab == NULL)
+	    return NULL;
+
+	slab->next = pool->slabs;
+	pool->slabs = slab;
+
+	for (i = N_ELEMENTS(slab->items) - 1; i >= 0; i--) {
+	    slab->items[i].next = pool->free_list;
+	    pool->free_list = &slab->items[i];
+	}
+    }
+
+    item = pool->free_list;
+    pool->free_list = item->next;
+
+    hangul_ic_init(&item->hic, &pool->output, pool, keyboard);
+
+    return &item->hic;
+}
+
+static void
+hangul_ic_pool_release(HangulInputContextPool* pool, HangulInputContext* hic)
+{
+    HangulICPoolItem* item = (HangulICPoolItem*)hic;
+
+    if (pool->output.owner == hic)
+	pool->output.owner = NULL;
+
+    item->next = pool->free_list;
+    pool->free_list = item;
+}
+
+/* 자판이 삭제되었거나 바뀌어서 다시 사용할 수 없는 표인지 확인한다. */
+static bool
+hangul_automaton_is_stale(const HangulAutomaton* automaton)
+{
+    return hangul_keyboard_is_deleted(automaton->keyboard) ||
+	   automaton->keyboard_serial !=
+	       hangul_keyboard_get_serial(automaton->keyboard);
+}
+
+/* 같은 설정의 표가 pool에 있으면 그것을 사용하고 없으면 새로 만든다.
+ * 다시 사용할 수 없는 표와 넘치는 표는 이때 pool 에서 뺀다. 그 표를 아직
+ * 사용하는 입력 상태가 있으면 그 입력 상태가 표를 바꿀 때 해제된다. */
+static HangulAutomaton*
+hangul_ic_pool_get_automaton(HangulInputContextPool* pool,
+			     const HangulInputContext* hic)
+{
+    HangulAutomaton* automaton = NULL;
+    int i, n;
+
+    n = 0;
+    for (i = 0; i < pool->nautomata; i++) {
+	HangulAutomaton* a = pool->automata[i];
+	if (hangul_automaton_is_stale(a)) {
+	    hangul_automaton_delete(a);
+	} else if (automaton == NULL && hangul_automaton_match(a, hic)) {
+	    automaton = a;
+	} else {
+	    pool->automata[n++] = a;
+	}
+    }
+    pool->nautomata = n;
+
+    if (automaton == NULL) {
+	automaton = hangul_automaton_new(hic);
+	if (automaton == NULL)
+	    return NULL;
+
+	if (pool->nautomata == HANGUL_IC_POOL_MAX_AUTOMATA)
+	    hangul_automaton_delete(pool->automata[--pool->nautomata]);
+    }
+
+    /* 맨 앞에 두어 가장 최근에 사용한 표로 만든다. */
+    memmove(pool->automata + 1, pool->automata,
+	    pool->nautomata * sizeof(pool->automata[0]));
+    pool->automata[0] = automaton;
+    pool->nautomata++;
+
+    return automaton;
+}
+
+/* hangul_ic_save_state() 의 저장 형식
+ *
+ *   "HIC" 버전(1)  매직과 형식 버전
+ *   flags(1)       HANGUL_IC_STATE_FLAG_* 의 조합
+ *   tableid(1)
+ *   n(1) id(n)     자판 id, 0으로 끝나지 않는다
+ *   cho jung jong  HangulBuffer의 각 값, 가변 길이 정수
+ *   m(1) stack(m)  HangulBuffer의 stack 중 사용하는 m개, 가변 길이 정수
+ *
+ * 가변 길이 정수는 하위 7비트씩 먼저 저장하고 뒤에 바이트가 더 있으면
+ * 최상위 비트를 켠다. 유니코드 값은 최대 3바이트가 된다. 형식이 바뀌면
+ * 버전을 올리고, 모르는 버전은 복원하지 않는다. */
+#define HANGUL_IC_STATE_VERSION 1
+
+enum {
+    HANGUL_IC_STATE_FLAG_AUTO_REORDER           = 1 << 0,
+    HANGUL_IC_STATE_FLAG_COMBI_ON_DOUBLE_STROKE = 1 << 1,
+    HANGUL_IC_STATE_FLAG_NON_CHOSEONG_COMBI     = 1 << 2,
+    HANGUL_IC_STATE_FLAG_TRANSITION_TABLE       = 1 << 3,
+    HANGUL_IC_STATE_FLAG_OUTPUT_JAMO            = 1 << 4,
+    HANGUL_IC_STATE_FLAG_JAMO_MODE_ONLY         = 1 << 5,
+    HANGUL_IC_STATE_FLAG_ALL                    = (1 << 6) - 1
+};
+
+static unsigned char*
+hangul_ic_state_put_ucs(unsigned char* p, ucschar c)
+{
+    while (c >= 0x80) {
+	*p++ = (c & 0x7f) | 0x80;
+	c >>= 7;
+    }
+    *p++ = c;
+    return p;
+}
+
+static const unsigned char*
+hangul_ic_state_get_ucs(const unsigned char* p, const unsigned char* end,
+			ucschar* c)
+{
+    ucschar value = 0;
+    int shift;
+
+    for (shift = 0; shift < 21; shift += 7) {
+	if (p >= end)
+	    return NULL;
+
+	value |= (ucschar)(*p & 0x7f) << shift;
+	if (!(*p++ & 0x80)) {
+	    if (value >= 0x110000)
+		return NULL;
+	    *c = value;
+	    return p;
+	}
+    }
+
+    return NULL;
+}
+
+/* 초성, 중성, 종성 값은 비어 있거나 stack 에서 같은 종류의 마지막 자모와
+ * 같아야 한다. 백스페이스로 지운 뒤에는 비어 있을 수 있다. 로마자 자판은
+ * 초성이 없을 때 stack 에 넣지 않고 초성 ㅇ을 채운다. */
+static bool
+hangul_ic_state_check_buffer(const HangulBuffer* buffer, bool is_romaja)
+{
+    ucschar choseong = 0;
+    ucschar jungseong = 0;
+    ucschar jongseong = 0;
+    int i;
+
+    for (i = 0; i <= buffer->index; i++) {
+	ucschar c = buffer->stack[i];
+	if (hangul_is_choseong(c))
+	    choseong = c;
+	else if (hangul_is_jungseong(c))
+	    jungseong = c;
+	else
+	    jongseong = c;
+    }
+
+    if (buffer->choseong != 0 && buffer->choseong != choseong) {
+	if (!is_romaja || choseong != 0 || buffer->choseong != 0x110b)
+	    return false;
+    }
+    if (buffer->jungseong != 0 && buffer->jungseong != jungseong)
+	return false;
+    if (buffer->jongseong != 0 && buffer->jongseong != jongseong)
+	return false;
+
+    return true;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief @ref HangulInputContext 의 조합 상태를 바이트 열로 저장하는 함수
+ * @param hic @ref HangulInputContext 오브젝트
+ * @param buf 상태를 저장할 버퍼
+ * @param buflen @a buf 의 크기, 바이트 단위
+ * @return 상태를 저장하는데 필요한 바이트 수, 실패하면 0
+ *
+ * 조합중인 글자와 자판, 조합 옵션, 출력 모드를 작은 바이트 열로 저장한다.
+ * 저장한 상태는 hangul_ic_restore_state() 로 다른 @ref HangulInputContext
+ * 에 복원할 수 있으므로, 입력 세션을 다른 프로세스로 옮길 때 사용한다.
+ * 바이트 열에는 포인터가 들어가지 않고 자판은 id로 저장한다.
+ *
+ * 리턴값이 @a buflen 보다 크면 아무것도 저장하지 않은 것이므로 그만큼의
+ * 버퍼를 준비해서 다시 불러야 한다. 필요한 크기는
+ * HANGUL_IC_STATE_SIZE_MAX 를 넘지 않는다.
+ * 콜백과 commit, flush 스트링은 저장하지 않는다. 자판 id가 255 바이트보다
+ * 길면 저장할 수 없다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시키지 않는다.
+ */
+int
+hangul_ic_save_state(HangulInputContext *hic, void *buf, int buflen)
+{
+    unsigned char state[HANGUL_IC_STATE_SIZE_MAX];
+    unsigned char* p = state;
+    const char* id;
+    size_t idlen;
+    int flags = 0;
+    int i;
+
+    if (hic == NULL)
+	return 0;
+
+    id = hangul_keyboard_get_id(hic->keyboard);
+    if (id == NULL)
+	id = "";
+    idlen = strlen(id);
+    if (idlen > 255 || hic->tableid < 0 || hic->tableid > 255)
+	return 0;
+
+    if (hic->option_auto_reorder)
+	flags |= HANGUL_IC_STATE_FLAG_AUTO_REORDER;
+    if (hic->option_combi_on_double_stroke)
+	flags |= HANGUL_IC_STATE_FLAG_COMBI_ON_DOUBLE_STROKE;
+    if (hic->option_non_choseong_combi)
+	flags |= HANGUL_IC_STATE_FLAG_NON_CHOSEONG_COMBI;
+    if (hic->option_transition_table)
+	flags |= HANGUL_IC_STATE_FLAG_TRANSITION_TABLE;
+    if (hic->output_mode == HANGUL_OUTPUT_JAMO)
+	flags |= HANGUL_IC_STATE_FLAG_OUTPUT_JAMO;
+    if (hic->use_jamo_mode_only)
+	flags |= HANGUL_IC_STATE_FLAG_JAMO_MODE_ONLY;
+
+    *p++ = 'H';
+    *p++ = 'I';
+    *p++ = 'C';
+    *p++ = HANGUL_IC_STATE_VERSION;
+    *p++ = flags;
+    *p++ = hic->tableid;
+    *p++ = idlen;
+    memcpy(p, id, idlen);
+    p += idlen;
+
+    p = hangul_ic_state_put_ucs(p, hic->buffer.choseong);
+    p = hangul_ic_state_put_ucs(p, hic->buffer.jungseong);
+    p = hangul_ic_state_put_ucs(p, hic->buffer.jongseong);
+    *p++ = hic->buffer.index + 1;
+    for (i = 0; i <= hic->buffer.index; i++)
+	p = hangul_ic_state_put_ucs(p, hic->buffer.stack[i]);
+
+    if (buf != NULL && p - state <= buflen)
+	memcpy(buf, state, p - state);
+
+    return p - state;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief hangul_ic_save_state() 로 저장한 조합 상태를 복원하는 함수
+ * @param hic 상태를 복원할 @ref HangulInputContext 오브젝트
+ * @param buf hangul_ic_save_state() 로 저장한 바이트 열
+ * @param len @a buf 의 길이, 바이트 단위
+ * @return 복원했으면 true, @a buf 가 올바른 형식이 아니거나 저장된 자판을
+ *         찾을 수 없으면 false
+ *
+ * @a hic 의 자판, 조합 옵션, 출력 모드와 조합중인 글자를 @a buf 에 저장된
+ * 것으로 바꾼다. preedit 스트링은 복원된 상태로 다시 만들어지고 commit,
+ * flush 스트링은 비워진다. 연결된 콜백은 그대로 유지된다.
+ * 실패한 경우에는 @a hic 를 바꾸지 않는다.
+ *
+ * @remarks 이 함수는 @ref HangulInputContext 의 상태를 변화 시킨다.
+ */
+bool
+hangul_ic_restore_state(HangulInputContext *hic, const void *buf, int len)
+{
+    const unsigned char* p = buf;
+    const unsigned char* end;
+    const HangulKeyboard* keyboard;
+    HangulBuffer buffer;
+    char id[256];
+    int flags;
+    int tableid;
+    int idlen;
+    int n;
+    int i;
+
+    if (hic == NULL || buf == NULL || len < 7)
+	return false;
+
+    end = p + len;
+    if (p[0] != 'H' || p[1] != 'I' || p[2] != 'C' ||
+	p[3] != HANGUL_IC_STATE_VERSION)
+	return false;
+
+    flags = p[4];
+    tableid = p[5];
+    idlen = p[6];
+    p += 7;
+    if ((flags & ~HANGUL_IC_STATE_FLAG_ALL) != 0 || end - p < idlen)
+	return false;
+
+    memcpy(id, p, idlen);
+    id[idlen] = '\0';
+    p += idlen;
+
+    p = hangul_ic_state_get_ucs(p, end, &buffer.choseong);
+    if (p != NULL)
+	p = hangul_ic_state_get_ucs(p, end, &buffer.jungseong);
+    if (p != NULL)
+	p = hangul_ic_state_get_ucs(p, end, &buffer.jongseong);
+    if (p == NULL || p >= end)
+	return false;
+
+    /* 다음 키를 처리할 때 하나 더 쌓을 수 있어야 한다. */
+    n = *p++;
+    if (n >= N_ELEMENTS(buffer.stack))
+	return false;
+
+    for (i = 0; i < n; i++) {
+	p = hangul_ic_state_get_ucs(p, end, &buffer.stack[i]);
+	if (p == NULL)
+	    return false;
+	if (!hangul_is_choseong(buffer.stack[i]) &&
+	    !hangul_is_jungseong(buffer.stack[i]) &&
+	    !hangul_is_jongseong(buffer.stack[i]))
+	    return false;
+    }
+    for (; i < N_ELEMENTS(buffer.stack); i++)
+	buffer.stack[i] = 0;
+    buffer.index = n - 1;
+
+    if (p != end)
+	return false;
+
+    keyboard = hangul_keyboard_list_get_keyboard(id);
+    if (keyboard == NULL)
+	return false;
+
+    if (!hangul_ic_state_check_buffer(&buffer,
+		hangul_keyboard_get_type(keyboard) == HANGUL_KEYBOARD_TYPE_ROMAJA))
+	return false;
+
+    hangul_ic_set_keyboard(hic, keyboard);
+    hic->tableid = tableid;
+    hic->use_jamo_mode_only = (flags & HANGUL_IC_STATE_FLAG_JAMO_MODE_ONLY) != 0;
+    hic->output_mode = (flags & HANGUL_IC_STATE_FLAG_OUTPUT_JAMO) ?
+		       HANGUL_OUTPUT_JAMO : HANGUL_OUTPUT_SYLLABLE;
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_AUTO_REORDER,
+			 flags & HANGUL_IC_STATE_FLAG_AUTO_REORDER);
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_COMBI_ON_DOUBLE_STROKE,
+			 flags & HANGUL_IC_STATE_FLAG_COMBI_ON_DOUBLE_STROKE);
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_NON_CHOSEONG_COMBI,
+			 flags & HANGUL_IC_STATE_FLAG_NON_CHOSEONG_COMBI);
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_TRANSITION_TABLE,
+			 flags & HANGUL_IC_STATE_FLAG_TRANSITION_TABLE);
+
+    hic->buffer = buffer;
+    hangul_ic_sync_automaton(hic);
+
+    /* 이전 기록은 이 상태에서 이어지지 않는다. */
+    if (hic->trace != NULL) {
+	hic->trace->head = 0;
+	hic->trace->count = 0;
+    }
+
+    hic->output->owner = hic;
+    hangul_ic_output_clear(hic->output);
+    hangul_ic_save_preedit_string(hic);
+
+    return true;
+}
+
+/* buf 에 들어갈 수 있으면 str 을 붙인다. 넘치더라도 필요한 길이는 계속
+ * 센다. */
+static int
+hangul_ic_trace_append(char* buf, int buflen, int len, const char* str)
+{
+    int n = strlen(str);
+
+    if (buf != NULL && len + n < buflen)
+	memcpy(buf + len, str, n + 1);
+
+    return len + n;
+}
+
+/**
+ * @ingroup hangulic
+ * @brief @ref HANGUL_IC_OPTION_TRACE 로 기록한 키 입력을 텍스트로 구하는 함수
+ * @param hic @ref HangulInputContext 오브젝트
+ * @param buf 기록을 저장할 버퍼
+ * @param buflen @a buf 의 크기, 바이트 단위
+ * @return 기록의 길이, 끝의 0은 포함하지 않는다. 기록하고 있지 않으면 0
+ *
+ * 최근의 키 입력 기록을 0으로 끝나는 텍스트로 @a buf 에 저장한다.
+ * 첫 줄은 주석이고, 그 다음 줄에는 기록을 시작할 때의 상태를
+ * hangul_ic_save_state() 의 결과를 16진수로 적은 "state" 줄이 온다.
+ * 그 뒤로 이벤트마다 한 줄씩 다음과 같이 적는다.
+ * @code
+ * key=107 ch=1161 res=1 commit=0 cho=1100 jung=1161 jong=0000
+ * @endcode
+ * 첫 필드는 "key=ASCII 값" 이거나 hangul_ic_reset() 과 hangul_ic_flush()
+ * 를 나타내는 "reset", "flush" 이다. ch 는 자판으로 바꾼 글자, res 는
+ * 키를 사용했는지 여부, commit 은 commit 스트링의 길이이고, cho, jung,
+ * jong 은 처리한 후의 조합 상태이다.
+ *
+ * state 줄의 상태에서 시작해서 같은 이벤트를 처리하면 같은 기록이
+ * 나오므로, 사용자의 입력 세션을 나중에 그대로 재현할 수 있다.
+ * 다만 transition, commit 콜백이 결과를 바꾼 경우에는 재현한 결과가
+ * 다를 수 있다.
+ * 링 버퍼가 덮어쓴 부분을 빼면 최근 128개에서 255개 사이의 이벤트가
+ * 들어간다.
+ *
+ * 리턴값이 @a buflen 보다 작지 않으면 버퍼가 부족한 것이다. 이 경우에도
+ * @a buf 에는 들어갈 수 있는 줄까지 저장한다.
+ */
+int
+hangul_ic_dump_trace(HangulInputContext *hic, char *buf, int buflen)
+{
+    const HangulICTrace* trace;
+    unsigned char state[HANGUL_IC_STATE_SIZE_MAX];
+    const unsigned char* snapshot;
+    int snapshot_len;
+    char hex[HANGUL_IC_STATE_SIZE_MAX * 2 + 8];
+    char line[128];
+    unsigned int start;
+    unsigned int n;
+    unsigned int i;
+    int len = 0;
+
+    if (buf != NULL && buflen > 0)
+	buf[0] = '\0';
+
+    if (hic == NULL || hic->trace == NULL)
+	return 0;
+
+    trace = hic->trace;
+    if (trace->count == 0) {
+	snapshot_len = hangul_ic_save_state(hic, state, sizeof(state));
+	snapshot = state;
+	start = 0;
+	n = 0;
+    } else if (trace->count < HANGUL_IC_TRACE_SIZE ||
+	       trace->head >= HANGUL_IC_TRACE_HALF) {
+	snapshot_len = trace->state_len[0];
+	snapshot = trace->state[0];
+	start = 0;
+	n = trace->head;
+    } else {
+	/* 앞쪽 절반을 다시 쓰고 있으므로 뒤쪽 절반부터 재현할 수 있다. */
+	snapshot_len = trace->state_len[1];
+	snapshot = trace->state[1];
+	start = HANGUL_IC_TRACE_HALF;
+	n = HANGUL_IC_TRACE_HALF + trace->head;
+    }
+
+    len = hangul_ic_trace_append(buf, buflen, len, "# libhangul trace\n");
+
+    strcpy(hex, "state ");
+    for (i = 0; i < snapshot_len; i++)
+	sprintf(hex + 6 + i * 2, "%02x", snapshot[i]);
+    strcat(hex, "\n");
+    len = hangul_ic_trace_append(buf, buflen, len, hex);
+
+    for (i = 0; i < n; i++) {
+	const HangulICTraceEntry* entry;
+	ucschar ch;
+	int l;
+
+	entry = &trace->entries[(start + i) % HANGUL_IC_TRACE_SIZE];
+
+	/* 기록하는 동안에는 자판이 바뀌지 않으므로 표로 처리한 키의 글자를
+	 * 지금 찾아도 된다. */
+	ch = entry->ch;
+	if (ch == 0 && entry->key >= 0 && entry->key != '\b' &&
+	    trace->keyboard == hic->keyboard)
+	    ch = hangul_keyboard_map_to_char(trace->keyboard,
+					     trace->config >> 8, entry->key);
+
+	if (entry->key == HANGUL_IC_TRACE_RESET)
+	    l = snprintf(line, sizeof(line), "reset");
+	else if (entry->key == HANGUL_IC_TRACE_FLUSH)
+	    l = snprintf(line, sizeof(line), "flush");
+	else
+	    l = snprintf(line, sizeof(line), "key=%d", entry->key);
+
+	snprintf(line + l, sizeof(line) - l,
+		 " ch=%04X res=%d commit=%d cho=%04X jung=%04X jong=%04X\n",
+		 ch, entry->result, entry->commit_len,
+		 entry->choseong, entry->jungseong, entry->jongseong);
+	len = hangul_ic_trace_append(buf, buflen, len, line);
+    }
+
+    return len;
+}
+
 /** @deprecated 이 함수 대신 @ref hangul_keyboard_list_get_count 를 사용하라 */
 unsigned int
 hangul_ic_get_n_keyboards()
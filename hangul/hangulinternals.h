@@ -29,11 +29,18 @@ ucschar hangul_choseong_to_jongseong(ucschar ch);
 ucschar hangul_jongseong_to_choseong(ucschar ch);
 void    hangul_jongseong_decompose(ucschar ch, ucschar* jong, ucschar* cho);
 
+const char* hangul_keyboard_get_id(const HangulKeyboard *keyboard);
 int     hangul_keyboard_get_type(const HangulKeyboard *keyboard);
 ucschar hangul_keyboard_combine(const HangulKeyboard* keyboard,
 	    unsigned id, ucschar first, ucschar second);
+const HangulCombination* hangul_keyboard_get_combination(
+	    const HangulKeyboard* keyboard, unsigned id);
 ucschar hangul_keyboard_map_to_char(const HangulKeyboard* keyboard,
 	    int tableid, unsigned key);
+long    hangul_keyboard_get_serial(const HangulKeyboard* keyboard);
+bool    hangul_keyboard_is_deleted(const HangulKeyboard* keyboard);
+const HangulKeyboard* hangul_keyboard_ref(const HangulKeyboard* keyboard);
+void    hangul_keyboard_unref(const HangulKeyboard* keyboard);
 
 int hangul_keyboard_list_init(const char* user_defined_keyboard_path);
 int hangul_keyboard_list_fini();
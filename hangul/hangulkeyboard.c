@@ -30,6 +30,17 @@
 #include <glob.h>
 #endif /* HAVE_GLOB_H */
 #include <expat.h>
+#ifndef _WIN32
+#include <sched.h>
+#endif /* _WIN32 */
+#ifdef HAVE_SYS_MMAN_H
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define HANGUL_KEYBOARD_CACHE 1
+#endif /* HAVE_SYS_MMAN_H */
 #endif /* ENABLE_EXTERNAL_KEYBOARDS */
 
 #include "hangul-gettext.h"
@@ -63,6 +74,14 @@
  * 인식하는 방식이므로 동일한 id를 가진 자판을 등록하면 먼저 등록된 자판만
  * 인식되므로 주의가 필요하다. 다시 말해서 시스템 자판과 같은 id를 가진
  * 자판은 등록하여 사용할 수 없다.
+ *
+ * 초기화할 때에는 키보드 파일의 앞부분에서 id와 이름만 읽는다. 자판
+ * 테이블과 조합 테이블은 그 자판을 처음 선택할 때 읽으므로, 키보드 파일의
+ * @<name@> 항목은 @<map@>, @<combination@>, @<include@> 항목보다 앞에
+ * 있어야 한다.
+ *
+ * 조합 테이블 하나만 들어 있는 파일을 include 하면, 같은 파일을 include 하는
+ * 자판들은 그 조합 테이블을 공유한다. 파일 내용이 바뀌면 새로 읽는다.
  */
 
 #define LIBHANGUL_KEYBOARD_DIR LIBHANGUL_DATA_DIR "/keyboards"
@@ -76,12 +95,39 @@ struct _HangulCombinationItem {
     ucschar code;
 };
 
+/* 조합 테이블은 찾을 때 사용하는 perfect hash를 따로 가진다.
+ * 키를 섞은 해시의 위쪽 비트로 bucket 을 고르고, 그 bucket 의
+ * displacement 를 해시에 더한 값의 아래쪽 비트로 슬롯을 정한다.
+ * 테이블을 만들 때 모든 키가 서로 다른 슬롯에 들어가도록 bucket 마다
+ * displacement 를 골라 두므로, 찾을 때에는 슬롯 하나만 비교하면 된다.
+ * 빈 슬롯은 code가 0이어서 찾지 못한 것과 결과가 같다.
+ * 내장 자판의 조합 테이블은 genkeyboard 가 같은 방법으로 만든다. */
 struct _HangulCombination {
     size_t size;
     size_t size_alloced;
     HangulCombinationItem *table;
 
     bool is_static;
+
+    uint32_t hash_seed;
+    uint32_t hash_shift;
+    uint32_t hash_mask;
+    const uint32_t* hash_disp;
+    const HangulCombinationItem* hash_slots;
+
+    /* 여러 자판이 같은 조합 테이블을 공유하므로 참조 횟수를 센다.
+     * is_static 인 테이블은 세지 않는다. */
+    long ref_count;
+};
+
+/* 외부 자판 파일은 처음에 id와 이름, 종류만 읽어 두고 path 에 파일 이름을
+ * 저장해 둔다. 자판 테이블과 조합 테이블은 처음 선택할 때 읽고
+ * load_state 를 HANGUL_KEYBOARD_LOADED 로 바꾼다. */
+enum {
+    HANGUL_KEYBOARD_LOADED,
+    HANGUL_KEYBOARD_PENDING,
+    HANGUL_KEYBOARD_LOADING,
+    HANGUL_KEYBOARD_LOAD_FAILED
 };
 
 struct _HangulKeyboard {
@@ -92,139 +138,70 @@ struct _HangulKeyboard {
 
     int type;
     bool is_static;
-};
-
-typedef struct _HangulKeyboardList {
-    size_t n;
-    size_t nalloced;
-    HangulKeyboard** keyboards;
-} HangulKeyboardList;
-
-#include "hangulkeyboard.h"
-
-static const HangulCombination hangul_combination_default = {
-    countof(hangul_combination_table_default),
-    countof(hangul_combination_table_default),
-    (HangulCombinationItem*)hangul_combination_table_default,
-    true
-};
-
-static const HangulCombination hangul_combination_romaja = {
-    countof(hangul_combination_table_romaja),
-    countof(hangul_combination_table_romaja),
-    (HangulCombinationItem*)hangul_combination_table_romaja,
-    true
-};
 
-static const HangulCombination hangul_combination_full = {
-    countof(hangul_combination_table_full),
-    countof(hangul_combination_table_full),
-    (HangulCombinationItem*)hangul_combination_table_full,
-    true
-};
-
-static const HangulCombination hangul_combination_ahn = {
-    countof(hangul_combination_table_ahn),
-    countof(hangul_combination_table_ahn),
-    (HangulCombinationItem*)hangul_combination_table_ahn,
-    true
-};
-
-static const HangulKeyboard hangul_keyboard_2 = {
-    (char*)"2",
-    (char*)N_("Dubeolsik"),
-    { (ucschar*)hangul_keyboard_table_2, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_default, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_JAMO,
-    true
-};
-
-static const HangulKeyboard hangul_keyboard_2y = {
-    (char*)"2y",
-    (char*)N_("Dubeolsik Yetgeul"),
-    { (ucschar*)hangul_keyboard_table_2y, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_full, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_JAMO_YET,
-    true
-};
+    char* path;
+    long load_state;
 
-static const HangulKeyboard hangul_keyboard_32 = {
-    (char*)"32",
-    (char*)N_("Sebeolsik Dubeol Layout"),
-    { (ucschar*)hangul_keyboard_table_32, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_default, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_JASO,
-    true
-};
+    /* 자판을 만들거나 바꿀 때마다 새로 받는 번호. 입력 상태의 상태 전이표는
+     * 자판의 주소와 이 번호가 모두 같을 때에만 다시 사용한다. */
+    long serial;
 
-static const HangulKeyboard hangul_keyboard_390 = {
-    (char*)"39",
-    (char*)N_("Sebeolsik 390"),
-    { (ucschar*)hangul_keyboard_table_390, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_default, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_JASO,
-    true
+    /* 상태 전이표도 자판을 참조하므로 hangul_keyboard_delete() 를 부른
+     * 뒤에도 참조가 남아 있으면 해제하지 않고 deleted 만 표시한다.
+     * 내장 자판은 세지 않는다. */
+    long ref_count;
+    long deleted;
 };
 
-static const HangulKeyboard hangul_keyboard_3final = {
-    (char*)"3f",
-    (char*)N_("Sebeolsik Final"),
-    { (ucschar*)hangul_keyboard_table_3final, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_default, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_JASO,
-    true
+static long hangul_keyboard_serial = 0;
+
+/* 등록된 자판 목록. 한번 공개한 목록은 바꾸지 않고, 자판을 등록하거나
+ * 삭제할 때에는 새 목록을 만들어서 포인터를 atomic하게 바꾼다. 따라서
+ * 목록을 읽는 쪽은 lock 없이 읽을 수 있다.
+ * 교체된 목록은 다른 스레드가 아직 읽고 있을 수 있으므로 retired 로
+ * 연결해 둔다. 목록을 읽는 쪽은 읽는 동안 hangul_keyboards_readers 를
+ * 올려 두고, 목록을 바꾼 쪽은 retired 목록들을 떼어낸 후에 읽는 스레드가
+ * 없으면 해제한다. 읽는 스레드가 있으면 다시 연결해 두었다가 다음에
+ * 해제한다. 목록을 바꾸는 쪽도 읽는 쪽을 기다리지 않는다. */
+typedef struct _HangulKeyboardList HangulKeyboardList;
+
+/* id로 자판을 찾는 해시 테이블의 슬롯. pos 는 자판 목록의 번호 + 1이고
+ * 0이면 빈 슬롯이다. 해시값을 같이 저장해서 해시가 같은 슬롯에서만
+ * 문자열을 비교한다. */
+typedef struct _HangulKeyboardIndexSlot {
+    uint32_t hash;
+    uint32_t pos;
+} HangulKeyboardIndexSlot;
+
+struct _HangulKeyboardList {
+    HangulKeyboardList* retired;
+    size_t n;
+    size_t index_mask;
+    HangulKeyboardIndexSlot* index;
+    HangulKeyboard* keyboards[];
 };
 
-static const HangulKeyboard hangul_keyboard_3sun = {
-    (char*)"3s",
-    (char*)N_("Sebeolsik Noshift"),
-    { (ucschar*)hangul_keyboard_table_3sun, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_default, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_JASO,
-    true
-};
+/* 내장 자판의 테이블과 hangul_builtin_keyboards[],
+ * hangul_builtin_keyboard_index[] 는 빌드할 때 genkeyboard 프로그램이
+ * data/keyboards 의 XML 파일에서 생성한다. */
+#include "hangulkeyboard.h"
 
-static const HangulKeyboard hangul_keyboard_3yet = {
-    (char*)"3y",
-    (char*)N_("Sebeolsik Yetgeul"),
-    { (ucschar*)hangul_keyboard_table_3yet, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_full, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_JASO_YET,
-    true
-};
+static const unsigned int hangul_builtin_keyboard_count = countof(hangul_builtin_keyboards);
 
-static const HangulKeyboard hangul_keyboard_romaja = {
-    (char*)"ro",
-    (char*)N_("Romaja"),
-    { (ucschar*)hangul_keyboard_table_romaja, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_romaja, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_ROMAJA,
-    true
-};
+static const size_t hangul_builtin_keyboard_index_mask = countof(hangul_builtin_keyboard_index) - 1;
 
-static const HangulKeyboard hangul_keyboard_ahn = {
-    (char*)"ahn",
-    (char*)N_("Ahnmatae"),
-    { (ucschar*)hangul_keyboard_table_ahn, NULL, NULL, NULL },
-    { (HangulCombination*)&hangul_combination_ahn, NULL, NULL, NULL },
-    HANGUL_KEYBOARD_TYPE_JASO,
-    true
-};
+static HangulKeyboardList* hangul_keyboards = NULL;
+static HangulKeyboardList* hangul_keyboards_retired = NULL;
+static long hangul_keyboards_readers = 0;
 
-static const HangulKeyboard* hangul_builtin_keyboards[] = {
-    &hangul_keyboard_2,
-    &hangul_keyboard_2y,
-    &hangul_keyboard_390,
-    &hangul_keyboard_3final,
-    &hangul_keyboard_3sun,
-    &hangul_keyboard_3yet,
-    &hangul_keyboard_32,
-    &hangul_keyboard_romaja,
-    &hangul_keyboard_ahn,
-};
-static const unsigned int hangul_builtin_keyboard_count = countof(hangul_builtin_keyboards);
+/* 자판을 만들 때 읽은 파일. 캐시가 유효한지 확인하는 데 사용한다. */
+typedef struct _HangulKeyboardSource {
+    char* path;
+    int64_t mtime;
+    int64_t size;
+} HangulKeyboardSource;
 
-static HangulKeyboardList hangul_keyboards = { 0, 0, NULL };
+#define HANGUL_KEYBOARD_MAX_SOURCES 16
 
 typedef struct _HangulKeyboardLoadContext {
     const char* path_stack[64];
@@ -233,12 +210,230 @@ typedef struct _HangulKeyboardLoadContext {
     int current_id;
     const char* current_element;
     bool save_name;
+    bool header_only;
+    bool name_found;
+    void* parser;
+    HangulKeyboardSource sources[HANGUL_KEYBOARD_MAX_SOURCES];
+    int nsources;
+    uint64_t content_hash[64];	/* path_stack 의 파일 내용의 해시 */
+    int depth;			/* 지금 파일 안에서 element 의 깊이 */
+    int combination_top;	/* 조합 파일을 읽는 중이면 그 path_stack 위치 */
 } HangulKeyboardLoadContext;
 
+/* include 한 조합 파일에서 만든 조합 테이블은 경로와 파일 내용의 해시로
+ * 찾을 수 있게 보관해 두고, 같은 파일을 include 하는 다른 자판은 파일을
+ * 다시 파싱하지 않고 이 테이블을 공유한다. 자판을 로딩하는 중에 다른
+ * 스레드가 같이 로딩할 수 있으므로 목록에 추가만 하고, hangul_fini() 에서
+ * 한번에 해제한다. */
+typedef struct _HangulCombinationEntry HangulCombinationEntry;
+
+struct _HangulCombinationEntry {
+    HangulCombinationEntry* next;
+    char* path;
+    uint64_t content_hash;
+    unsigned int id;
+    HangulCombination* combination;
+};
+
 #if ENABLE_EXTERNAL_KEYBOARDS
+static HangulCombinationEntry* hangul_combination_entries = NULL;
+
 static void    hangul_keyboard_parse_file(const char* path, HangulKeyboardLoadContext* context);
 #endif // ENABLE_EXTERNAL_KEYBOARDS
-static bool    hangul_keyboard_list_append(HangulKeyboard* keyboard);
+static bool    hangul_keyboard_list_append(HangulKeyboard** keyboards, size_t n);
+
+static inline HangulKeyboardList*
+hangul_keyboard_list_load(HangulKeyboardList** list)
+{
+#ifdef _MSC_VER
+    return InterlockedCompareExchangePointer((PVOID volatile*)list, NULL, NULL);
+#else
+    return __atomic_load_n(list, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline HangulKeyboardList*
+hangul_keyboard_list_exchange(HangulKeyboardList** list,
+			      HangulKeyboardList* desired)
+{
+#ifdef _MSC_VER
+    return InterlockedExchangePointer((PVOID volatile*)list, desired);
+#else
+    return __atomic_exchange_n(list, desired, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/* 목록을 읽기 시작할 때 부르고, 돌려받은 목록을 다 사용하면
+ * hangul_keyboard_list_release() 를 부른다. */
+static inline const HangulKeyboardList*
+hangul_keyboard_list_acquire(void)
+{
+#ifdef _MSC_VER
+    InterlockedIncrement(&hangul_keyboards_readers);
+#else
+    __atomic_add_fetch(&hangul_keyboards_readers, 1, __ATOMIC_SEQ_CST);
+#endif
+    return hangul_keyboard_list_load(&hangul_keyboards);
+}
+
+static inline void
+hangul_keyboard_list_release(void)
+{
+#ifdef _MSC_VER
+    InterlockedDecrement(&hangul_keyboards_readers);
+#else
+    __atomic_sub_fetch(&hangul_keyboards_readers, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline long
+hangul_keyboard_state_load(long* state)
+{
+#ifdef _MSC_VER
+    return InterlockedCompareExchange(state, 0, 0);
+#else
+    return __atomic_load_n(state, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline void
+hangul_keyboard_state_store(long* state, long value)
+{
+#ifdef _MSC_VER
+    InterlockedExchange(state, value);
+#else
+    __atomic_store_n(state, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline bool
+hangul_keyboard_state_cas(long* state, long expected, long desired)
+{
+#ifdef _MSC_VER
+    return InterlockedCompareExchange(state, desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(state, &expected, desired, false,
+				       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline long
+hangul_keyboard_state_add(long* state, long value)
+{
+#ifdef _MSC_VER
+    return InterlockedExchangeAdd(state, value) + value;
+#else
+    return __atomic_add_fetch(state, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline long
+hangul_keyboard_list_readers(void)
+{
+#ifdef _MSC_VER
+    return InterlockedCompareExchange(&hangul_keyboards_readers, 0, 0);
+#else
+    return __atomic_load_n(&hangul_keyboards_readers, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline bool
+hangul_keyboard_list_cas(HangulKeyboardList** list,
+			 HangulKeyboardList* expected, HangulKeyboardList* desired)
+{
+#ifdef _MSC_VER
+    return InterlockedCompareExchangePointer((PVOID volatile*)list,
+					     desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(list, &expected, desired, false,
+				       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static inline size_t
+hangul_keyboard_list_size(const HangulKeyboardList* list)
+{
+    return list != NULL ? list->n : 0;
+}
+
+/* 자판 id의 FNV-1a 해시. genkeyboard 가 내장 자판의 해시 테이블을 만들 때
+ * 같은 함수를 사용하므로 두 곳을 같이 고쳐야 한다. */
+static inline uint32_t
+hangul_keyboard_id_hash(const char* id)
+{
+    uint32_t h = 2166136261u;
+
+    while (*id != '\0') {
+	h ^= (unsigned char)*id++;
+	h *= 16777619u;
+    }
+    return h;
+}
+
+/* index 에서 id를 찾아서 자판 목록의 번호를 리턴한다. 없으면 -1. */
+static inline int
+hangul_keyboard_index_lookup(const HangulKeyboardIndexSlot* index, size_t mask,
+			     const HangulKeyboard* const* keyboards,
+			     const char* id, uint32_t hash)
+{
+    size_t i = hash & mask;
+
+    while (index[i].pos != 0) {
+	const HangulKeyboard* keyboard = keyboards[index[i].pos - 1];
+	if (index[i].hash == hash && strcmp(id, keyboard->id) == 0)
+	    return index[i].pos - 1;
+	i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+/* n 개의 자판을 담을 목록을 할당한다. 해시 테이블은 자판 포인터 배열
+ * 뒤에 같이 할당하고, 자판을 다 채운 후에
+ * hangul_keyboard_list_build_index() 로 만든다. */
+static HangulKeyboardList*
+hangul_keyboard_list_new(size_t n)
+{
+    HangulKeyboardList* list;
+    size_t index_size = 8;
+
+    while (index_size < n * 2)
+	index_size *= 2;
+
+    list = malloc(sizeof(*list) + n * sizeof(list->keyboards[0]) +
+		  index_size * sizeof(list->index[0]));
+    if (list == NULL)
+	return NULL;
+
+    list->retired = NULL;
+    list->n = n;
+    list->index_mask = index_size - 1;
+    list->index = (HangulKeyboardIndexSlot*)(list->keyboards + n);
+    return list;
+}
+
+/* 같은 id가 여러개 있으면 나중에 등록된 자판이 선택되도록 뒤의 자판으로
+ * 슬롯을 덮어 쓴다. */
+static void
+hangul_keyboard_list_build_index(HangulKeyboardList* list)
+{
+    size_t i;
+
+    memset(list->index, 0, (list->index_mask + 1) * sizeof(list->index[0]));
+    for (i = 0; i < list->n; ++i) {
+	const char* id = list->keyboards[i]->id;
+	uint32_t hash = hangul_keyboard_id_hash(id);
+	size_t slot = hash & list->index_mask;
+
+	while (list->index[slot].pos != 0) {
+	    const HangulKeyboard* keyboard = list->keyboards[list->index[slot].pos - 1];
+	    if (list->index[slot].hash == hash && strcmp(id, keyboard->id) == 0)
+		break;
+	    slot = (slot + 1) & list->index_mask;
+	}
+	list->index[slot].hash = hash;
+	list->index[slot].pos = i + 1;
+    }
+}
 
 HangulCombination*
 hangul_combination_new()
@@ -249,6 +444,12 @@ hangul_combination_new()
 	combination->size_alloced = 0;
 	combination->table = NULL;
 	combination->is_static = false;
+	combination->hash_seed = 0;
+	combination->hash_shift = 31;
+	combination->hash_mask = 0;
+	combination->hash_disp = NULL;
+	combination->hash_slots = NULL;
+	combination->ref_count = 1;
 	return combination;
     }
 
@@ -264,18 +465,222 @@ hangul_combination_delete(HangulCombination *combination)
     if (combination->is_static)
 	return;
 
+#ifdef _MSC_VER
+    if (InterlockedDecrement(&combination->ref_count) > 0)
+	return;
+#else
+    if (__atomic_sub_fetch(&combination->ref_count, 1, __ATOMIC_SEQ_CST) > 0)
+	return;
+#endif
+
     if (combination->table != NULL)
 	free(combination->table);
 
+    /* hash_disp 는 hash_slots 와 같이 할당한다. */
+    free((void*)combination->hash_slots);
     free(combination);
 }
 
+#if ENABLE_EXTERNAL_KEYBOARDS
+static HangulCombination*
+hangul_combination_ref(HangulCombination* combination)
+{
+    if (combination == NULL || combination->is_static)
+	return combination;
+
+#ifdef _MSC_VER
+    InterlockedIncrement(&combination->ref_count);
+#else
+    __atomic_add_fetch(&combination->ref_count, 1, __ATOMIC_SEQ_CST);
+#endif
+    return combination;
+}
+#endif /* ENABLE_EXTERNAL_KEYBOARDS */
+
 static uint32_t
 hangul_combination_make_key(ucschar first, ucschar second)
 {
     return first << 16 | second;
 }
 
+/* genkeyboard 의 combination_hash() 와 같아야 한다. */
+static inline uint32_t
+hangul_combination_hash(uint32_t key, uint32_t seed)
+{
+    uint32_t h = (key ^ seed) * 0x9e3779b1u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h;
+}
+
+/* seed 로 각 키의 슬롯이 겹치지 않는 displacement 를 찾아본다.
+ * 키가 많은 bucket 부터 자리를 잡아야 잘 채워진다. */
+static bool
+hangul_combination_try_hash(const HangulCombination* combination, uint32_t seed,
+			    unsigned bucket_bits, size_t nslots,
+			    HangulCombinationItem* slots, uint32_t* disp,
+			    uint32_t* hashes, uint32_t* order, uint32_t* start,
+			    bool* used)
+{
+    size_t nbuckets = (size_t)1 << bucket_bits;
+    size_t mask = nslots - 1;
+    size_t n = combination->size;
+    size_t max_size = 0;
+    size_t i, j, k, b, size;
+    uint32_t d;
+
+    memset(start, 0, (nbuckets + 1) * sizeof(start[0]));
+    memset(used, 0, nslots * sizeof(used[0]));
+    memset(slots, 0, nslots * sizeof(slots[0]));
+    memset(disp, 0, nbuckets * sizeof(disp[0]));
+
+    for (i = 0; i < n; ++i) {
+	hashes[i] = hangul_combination_hash(combination->table[i].key, seed);
+	start[(hashes[i] >> (32 - bucket_bits)) + 1]++;
+    }
+    for (b = 0; b < nbuckets; ++b) {
+	if (start[b + 1] > max_size)
+	    max_size = start[b + 1];
+	start[b + 1] += start[b];
+    }
+    /* order 에 bucket 별로 키의 번호를 모은다. 모으는 동안 start[b] 가
+     * bucket b 의 끝으로 옮겨가므로 모은 후에 한칸씩 밀어서, start[b] 부터
+     * start[b + 1] 까지가 bucket b 가 되게 한다. */
+    for (i = 0; i < n; ++i) {
+	b = hashes[i] >> (32 - bucket_bits);
+	order[start[b]++] = i;
+    }
+    for (b = nbuckets; b > 0; --b)
+	start[b] = start[b - 1];
+    start[0] = 0;
+
+    for (size = max_size; size > 0; --size) {
+	for (b = 0; b < nbuckets; ++b) {
+	    uint32_t* members;
+	    size_t count;
+
+	    if (start[b + 1] - start[b] != size)
+		continue;
+
+	    members = order + start[b];
+	    count = 0;
+	    /* 같은 키가 여러번 있으면 처음 것만 사용한다. */
+	    for (j = 0; j < size; ++j) {
+		uint32_t key = combination->table[members[j]].key;
+		for (k = 0; k < count; ++k) {
+		    if (combination->table[members[k]].key == key)
+			break;
+		}
+		if (k == count)
+		    members[count++] = members[j];
+	    }
+
+	    for (d = 0; d < nslots; ++d) {
+		for (j = 0; j < count; ++j) {
+		    size_t slot = (hashes[members[j]] + d) & mask;
+		    if (used[slot])
+			break;
+		    used[slot] = true;
+		}
+		if (j == count)
+		    break;
+		while (j > 0) {
+		    --j;
+		    used[(hashes[members[j]] + d) & mask] = false;
+		}
+	    }
+	    if (d == nslots)
+		return false;
+
+	    disp[b] = d;
+	    for (j = 0; j < count; ++j)
+		slots[(hashes[members[j]] + d) & mask] = combination->table[members[j]];
+	}
+    }
+
+    return true;
+}
+
+static bool
+hangul_combination_build_hash(HangulCombination* combination)
+{
+    size_t n = combination->size;
+    size_t nslots = 2;
+    size_t nbuckets = 2;
+    unsigned bucket_bits = 1;
+    uint32_t seed;
+
+    if (combination->is_static)
+	return false;
+
+    free((void*)combination->hash_slots);
+    combination->hash_seed = 0;
+    combination->hash_shift = 31;
+    combination->hash_mask = 0;
+    combination->hash_disp = NULL;
+    combination->hash_slots = NULL;
+
+    if (n == 0)
+	return true;
+    if (n > UINT32_MAX / 2)
+	return false;
+
+    while (nslots < n + n / 4)
+	nslots *= 2;
+    while (nbuckets < n / 4 && bucket_bits < 31) {
+	nbuckets *= 2;
+	bucket_bits++;
+    }
+
+    uint32_t* hashes = malloc(n * 2 * sizeof(hashes[0]) +
+			      (nbuckets + 1) * sizeof(hashes[0]));
+    if (hashes == NULL)
+	return false;
+
+    uint32_t* order = hashes + n;
+    uint32_t* start = order + n;
+
+    /* 대부분 처음 몇개의 seed 에서 만들어진다. 그래도 안되면 슬롯을
+     * 늘려서 다시 해본다. */
+    while (nslots <= UINT32_MAX) {
+	HangulCombinationItem* slots;
+	uint32_t* disp;
+	bool* used;
+
+	slots = malloc(nslots * sizeof(slots[0]) + nbuckets * sizeof(disp[0]));
+	used = malloc(nslots * sizeof(used[0]));
+	if (slots == NULL || used == NULL) {
+	    free(slots);
+	    free(used);
+	    break;
+	}
+	disp = (uint32_t*)(slots + nslots);
+
+	for (seed = 0; seed < 64; ++seed) {
+	    if (hangul_combination_try_hash(combination, seed * 0x9e3779b9u,
+					    bucket_bits, nslots, slots, disp,
+					    hashes, order, start, used)) {
+		combination->hash_seed = seed * 0x9e3779b9u;
+		combination->hash_shift = 32 - bucket_bits;
+		combination->hash_mask = nslots - 1;
+		combination->hash_disp = disp;
+		combination->hash_slots = slots;
+		free(used);
+		free(hashes);
+		return true;
+	    }
+	}
+
+	free(slots);
+	free(used);
+	nslots *= 2;
+    }
+
+    free(hashes);
+    return false;
+}
+
 bool
 hangul_combination_set_data(HangulCombination* combination,
 			    ucschar* first, ucschar* second, ucschar* result,
@@ -296,7 +701,7 @@ hangul_combination_set_data(HangulCombination* combination,
 	    combination->table[i].key = hangul_combination_make_key(first[i], second[i]);
 	    combination->table[i].code = result[i];
 	}
-	return true;
+	return hangul_combination_build_hash(combination);
     }
 
     return false;
@@ -338,54 +743,92 @@ hangul_combination_add_item(HangulCombination* combination,
 }
 #endif // ENABLE_EXTERNAL_KEYBOARDS
 
-static int
-hangul_combination_cmp(const void* p1, const void* p2)
+static ucschar
+hangul_combination_combine(const HangulCombination* combination,
+			   ucschar first, ucschar second)
 {
-    const HangulCombinationItem *item1 = p1;
-    const HangulCombinationItem *item2 = p2;
+    const HangulCombinationItem* item;
+    uint32_t key;
+    uint32_t h;
 
-    /* key는 unsigned int이므로 단순히 빼서 리턴하면 안된다.
-     * 두 수의 차가 큰 경우 int로 변환하면서 음수가 될 수 있다. */
-    if (item1->key < item2->key)
-	return -1;
-    else if (item1->key > item2->key)
-	return 1;
-    else
+    if (combination == NULL || combination->hash_slots == NULL)
 	return 0;
+
+    key = hangul_combination_make_key(first, second);
+    h = hangul_combination_hash(key, combination->hash_seed);
+    h += combination->hash_disp[h >> combination->hash_shift];
+    item = &combination->hash_slots[h & combination->hash_mask];
+    return item->key == key ? item->code : 0;
 }
 
-#if ENABLE_EXTERNAL_KEYBOARDS
+/* 자판의 내용이 바뀌었음을 표시한다. */
 static void
-hangul_combination_sort(HangulCombination* combination)
+hangul_keyboard_touch(HangulKeyboard* keyboard)
 {
-    if (combination == NULL)
+    if (keyboard->is_static)
 	return;
 
-    if (combination->is_static)
-	return;
+    hangul_keyboard_state_store(&keyboard->serial,
+	    hangul_keyboard_state_add(&hangul_keyboard_serial, 1));
+}
 
-    qsort(combination->table, combination->size,
-	sizeof(combination->table[0]), hangul_combination_cmp);
+long
+hangul_keyboard_get_serial(const HangulKeyboard* keyboard)
+{
+    if (keyboard == NULL)
+	return 0;
+
+    return hangul_keyboard_state_load((long*)&keyboard->serial);
 }
-#endif // ENABLE_EXTERNAL_KEYBOARDS
 
-static ucschar
-hangul_combination_combine(const HangulCombination* combination,
-			   ucschar first, ucschar second)
+bool
+hangul_keyboard_is_deleted(const HangulKeyboard* keyboard)
 {
-    HangulCombinationItem *res;
-    HangulCombinationItem key;
+    if (keyboard == NULL || keyboard->is_static)
+	return false;
 
-    if (combination == NULL)
-	return 0;
+    return hangul_keyboard_state_load((long*)&keyboard->deleted) != 0;
+}
+
+const HangulKeyboard*
+hangul_keyboard_ref(const HangulKeyboard* keyboard)
+{
+    if (keyboard != NULL && !keyboard->is_static)
+	hangul_keyboard_state_add((long*)&keyboard->ref_count, 1);
+    return keyboard;
+}
 
-    key.key = hangul_combination_make_key(first, second);
-    res = bsearch(&key, combination->table, combination->size,
-	          sizeof(combination->table[0]), hangul_combination_cmp);
-    if (res != NULL)
-	return res->code;
+static void
+hangul_keyboard_free(HangulKeyboard* keyboard)
+{
+    free(keyboard->id);
+    free(keyboard->name);
 
-    return 0;
+    unsigned i;
+    for (i = 0; i < countof(keyboard->table); ++i) {
+	if (keyboard->table[i] != NULL) {
+	    free(keyboard->table[i]);
+	}
+    }
+
+    for (i = 0; i < countof(keyboard->combination); ++i) {
+	if (keyboard->combination[i] != NULL) {
+	    hangul_combination_delete(keyboard->combination[i]);
+	}
+    }
+
+    free(keyboard->path);
+    free(keyboard);
+}
+
+void
+hangul_keyboard_unref(const HangulKeyboard* keyboard)
+{
+    if (keyboard == NULL || keyboard->is_static)
+	return;
+
+    if (hangul_keyboard_state_add((long*)&keyboard->ref_count, -1) == 0)
+	hangul_keyboard_free((HangulKeyboard*)keyboard);
 }
 
 HangulKeyboard*
@@ -411,6 +854,14 @@ hangul_keyboard_new()
     keyboard->type = HANGUL_KEYBOARD_TYPE_JAMO;
     keyboard->is_static = false;
 
+    keyboard->path = NULL;
+    keyboard->load_state = HANGUL_KEYBOARD_LOADED;
+
+    keyboard->serial = 0;
+    keyboard->ref_count = 1;
+    keyboard->deleted = 0;
+    hangul_keyboard_touch(keyboard);
+
     return keyboard;
 }
 
@@ -485,6 +936,7 @@ hangul_keyboard_set_mapping(HangulKeyboard *keyboard, int tableid, unsigned key,
 
     ucschar* table = keyboard->table[tableid];
     table[key] = value;
+    hangul_keyboard_touch(keyboard);
 }
 
 void
@@ -493,6 +945,14 @@ hangul_keyboard_set_value(HangulKeyboard *keyboard, int key, ucschar value)
     hangul_keyboard_set_mapping(keyboard, 0, key, value);
 }
 
+const char*
+hangul_keyboard_get_id(const HangulKeyboard *keyboard)
+{
+    if (keyboard == NULL)
+	return NULL;
+    return keyboard->id;
+}
+
 int
 hangul_keyboard_get_type(const HangulKeyboard *keyboard)
 {
@@ -508,6 +968,7 @@ hangul_keyboard_set_type(HangulKeyboard *keyboard, int type)
 {
     if (keyboard != NULL) {
 	keyboard->type = type;
+	hangul_keyboard_touch(keyboard);
     }
 }
 
@@ -520,23 +981,8 @@ hangul_keyboard_delete(HangulKeyboard *keyboard)
     if (keyboard->is_static)
 	return;
 
-    free(keyboard->id);
-    free(keyboard->name);
-
-    unsigned i;
-    for (i = 0; i < countof(keyboard->table); ++i) {
-	if (keyboard->table[i] != NULL) {
-	    free(keyboard->table[i]);
-	}
-    }
-
-    for (i = 0; i < countof(keyboard->combination); ++i) {
-	if (keyboard->combination[i] != NULL) {
-	    hangul_combination_delete(keyboard->combination[i]);
-	}
-    }
-
-    free(keyboard);
+    hangul_keyboard_state_store(&keyboard->deleted, 1);
+    hangul_keyboard_unref(keyboard);
 }
 
 ucschar
@@ -554,9 +1000,18 @@ hangul_keyboard_combine(const HangulKeyboard* keyboard,
     return res;
 }
 
-#if ENABLE_EXTERNAL_KEYBOARDS
-static const char*
-attr_lookup(const char** attr, const char* name)
+const HangulCombination*
+hangul_keyboard_get_combination(const HangulKeyboard* keyboard, unsigned id)
+{
+    if (keyboard == NULL || id >= countof(keyboard->combination))
+	return NULL;
+
+    return keyboard->combination[id];
+}
+
+#if ENABLE_EXTERNAL_KEYBOARDS
+static const char*
+attr_lookup(const char** attr, const char* name)
 {
     if (attr == NULL)
 	return NULL;
@@ -582,11 +1037,134 @@ attr_lookup_as_uint(const char** attr, const char* name)
     return value;
 }
 
+static uint64_t
+hangul_keyboard_content_hash(const char* data, size_t len)
+{
+    uint64_t h = 14695981039346656037ull;
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+	h ^= (unsigned char)data[i];
+	h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static HangulCombinationEntry*
+hangul_combination_entry_lookup(const char* path, uint64_t content_hash)
+{
+    HangulCombinationEntry* entry;
+
+#ifdef _MSC_VER
+    entry = InterlockedCompareExchangePointer((PVOID volatile*)&hangul_combination_entries, NULL, NULL);
+#else
+    entry = __atomic_load_n(&hangul_combination_entries, __ATOMIC_SEQ_CST);
+#endif
+    for (; entry != NULL; entry = entry->next) {
+	if (entry->content_hash == content_hash && strcmp(entry->path, path) == 0)
+	    return entry;
+    }
+    return NULL;
+}
+
+/* 자판의 조합 테이블이 조합 파일에서 읽어서 공유하는 것이면 그 항목을
+ * 리턴한다. */
+static const HangulCombinationEntry*
+hangul_combination_entry_find(unsigned int id, const HangulCombination* combination)
+{
+    HangulCombinationEntry* entry;
+
+    if (combination == NULL)
+	return NULL;
+
+#ifdef _MSC_VER
+    entry = InterlockedCompareExchangePointer((PVOID volatile*)&hangul_combination_entries, NULL, NULL);
+#else
+    entry = __atomic_load_n(&hangul_combination_entries, __ATOMIC_SEQ_CST);
+#endif
+    for (; entry != NULL; entry = entry->next) {
+	if (entry->id == id && entry->combination == combination)
+	    return entry;
+    }
+    return NULL;
+}
+
+/* 같은 파일을 두 스레드가 동시에 추가하면 목록에 두번 들어가지만 어느
+ * 것을 찾아도 결과는 같다. */
+static void
+hangul_combination_entry_add(const char* path, uint64_t content_hash,
+			     unsigned int id, HangulCombination* combination)
+{
+    HangulCombinationEntry* entry = malloc(sizeof(*entry));
+    if (entry == NULL)
+	return;
+
+    entry->path = strdup(path);
+    if (entry->path == NULL) {
+	free(entry);
+	return;
+    }
+    entry->content_hash = content_hash;
+    entry->id = id;
+    entry->combination = hangul_combination_ref(combination);
+
+#ifdef _MSC_VER
+    do {
+	entry->next = hangul_combination_entries;
+    } while (InterlockedCompareExchangePointer((PVOID volatile*)&hangul_combination_entries,
+					       entry, entry->next) != entry->next);
+#else
+    entry->next = __atomic_load_n(&hangul_combination_entries, __ATOMIC_SEQ_CST);
+    while (!__atomic_compare_exchange_n(&hangul_combination_entries, &entry->next,
+					entry, false,
+					__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+	;
+#endif
+}
+
+/* 다른 스레드가 자판을 로딩하지 않을 때에만 불러야 한다. */
+static void
+hangul_combination_entry_clear()
+{
+    HangulCombinationEntry* entry = hangul_combination_entries;
+
+    hangul_combination_entries = NULL;
+    while (entry != NULL) {
+	HangulCombinationEntry* next = entry->next;
+	hangul_combination_delete(entry->combination);
+	free(entry->path);
+	free(entry);
+	entry = next;
+    }
+}
+
+/* 이미 읽은 조합 파일이면 그 조합 테이블을 자판에 설정한다. */
+static bool
+hangul_keyboard_include_combination(HangulKeyboardLoadContext* context,
+				    const char* path, uint64_t content_hash)
+{
+    HangulCombinationEntry* entry;
+
+    entry = hangul_combination_entry_lookup(path, content_hash);
+    if (entry == NULL)
+	return false;
+
+    if (context->keyboard != NULL &&
+	entry->id < countof(context->keyboard->combination)) {
+	hangul_combination_delete(context->keyboard->combination[entry->id]);
+	context->keyboard->combination[entry->id] =
+	    hangul_combination_ref(entry->combination);
+    }
+    return true;
+}
+
 static void XMLCALL
 on_element_start(void* data, const XML_Char* element, const XML_Char** attr)
 {
     HangulKeyboardLoadContext* context = (HangulKeyboardLoadContext*)data;
 
+    context->depth++;
+
     if (strcmp(element, "hangul-keyboard") == 0) {
 	if (context->keyboard != NULL) {
 	    hangul_keyboard_delete(context->keyboard);
@@ -626,6 +1204,12 @@ on_element_start(void* data, const XML_Char* element, const XML_Char** attr)
 	    }
 	}
 	context->current_element = "name";
+    } else if (context->header_only) {
+	/* 이름은 보통 테이블보다 앞에 있으므로 이름을 읽은 후에는 나머지를
+	 * 읽지 않는다. 이름이 테이블 뒤에 있는 자판 파일도 있으므로 이름을
+	 * 찾기 전까지는 다른 element 를 건너뛰면서 계속 읽는다. */
+	if (context->name_found)
+	    XML_StopParser((XML_Parser)context->parser, XML_FALSE);
     } else if (strcmp(element, "map") == 0) {
 	if (context->keyboard == NULL)
 	    return;
@@ -648,153 +1232,803 @@ on_element_start(void* data, const XML_Char* element, const XML_Char** attr)
 	    context->current_id = id;
 	    context->current_element = "combination";
 	    context->keyboard->combination[id] = hangul_combination_new();
+
+	    /* include 한 파일 전체가 조합 테이블 하나이면 공유할 수 있다. */
+	    if (context->path_stack_top > 0 && context->depth == 1)
+		context->combination_top = context->path_stack_top;
 	}
     } else if (strcmp(element, "item") == 0) {
 	if (context->keyboard == NULL)
 	    return;
 
-	unsigned int id = context->current_id;
-	if (strcmp(context->current_element, "map") == 0) {
-	    HangulKeyboard* keyboard = context->keyboard;
-	    unsigned int key = attr_lookup_as_uint(attr, "key");
-	    unsigned int value = attr_lookup_as_uint(attr, "value");
-	    hangul_keyboard_set_mapping(keyboard, id, key, value);
-	} else if (strcmp(context->current_element, "combination") == 0) {
-	    HangulCombination* combination = context->keyboard->combination[id];
-	    unsigned int first = attr_lookup_as_uint(attr, "first");
-	    unsigned int second = attr_lookup_as_uint(attr, "second");
-	    unsigned int result = attr_lookup_as_uint(attr, "result");
-	    hangul_combination_add_item(combination, first, second, result);
+	unsigned int id = context->current_id;
+	if (strcmp(context->current_element, "map") == 0) {
+	    HangulKeyboard* keyboard = context->keyboard;
+	    unsigned int key = attr_lookup_as_uint(attr, "key");
+	    unsigned int value = attr_lookup_as_uint(attr, "value");
+	    hangul_keyboard_set_mapping(keyboard, id, key, value);
+	} else if (strcmp(context->current_element, "combination") == 0) {
+	    HangulCombination* combination = context->keyboard->combination[id];
+	    unsigned int first = attr_lookup_as_uint(attr, "first");
+	    unsigned int second = attr_lookup_as_uint(attr, "second");
+	    unsigned int result = attr_lookup_as_uint(attr, "result");
+	    hangul_combination_add_item(combination, first, second, result);
+	}
+    } else if (strcmp(element, "include") == 0) {
+	const char* file = attr_lookup(attr, "file");
+	if (file == NULL)
+	    return;
+
+	/* 다른 파일을 포함하는 조합 테이블은 그 파일이 바뀐 것을 알 수
+	 * 없으므로 공유하지 않는다. */
+	context->combination_top = 0;
+
+        int top = context->path_stack_top;
+        if (top < 0)
+            return;
+
+        size_t n = strlen(file) + strlen(context->path_stack[top]) + 1;
+	char* path = malloc(n);
+	if (path == NULL)
+	    return;
+
+	if (file[0] == '/') {
+	    strncpy(path, file, n);
+	} else {
+	    char* orig_path = strdup(context->path_stack[top]);
+	    char* last_slash = strrchr(orig_path, '/');
+	    if (last_slash)
+		last_slash[0] = '\0';
+
+	    snprintf(path, n, "%s/%s", orig_path, file);
+	    free(orig_path);
+	}
+
+	hangul_keyboard_parse_file(path, context);
+	free(path);
+    }
+}
+
+static void XMLCALL
+on_element_end(void* data, const XML_Char* element)
+{
+    HangulKeyboardLoadContext* context = (HangulKeyboardLoadContext*)data;
+
+    context->depth--;
+
+    if (context->keyboard == NULL)
+	return;
+
+    if (strcmp(element, "name") == 0) {
+	context->current_element = "";
+	context->save_name = false;
+	context->name_found = true;
+    } else if (context->header_only) {
+	/* 헤더만 읽을 때는 테이블을 만들지 않는다. */
+	return;
+    } else if (strcmp(element, "map") == 0) {
+	context->current_id = 0;
+	context->current_element = "";
+    } else if (strcmp(element, "combination") == 0) {
+	unsigned int id = context->current_id;
+	HangulCombination* combination = context->keyboard->combination[id];
+	hangul_combination_build_hash(combination);
+	if (context->combination_top > 0) {
+	    int top = context->combination_top;
+	    hangul_combination_entry_add(context->path_stack[top],
+		    context->content_hash[top], id, combination);
+	    context->combination_top = 0;
+	}
+	context->current_id = 0;
+	context->current_element = "";
+    }
+}
+
+static void XMLCALL
+on_char_data(void* data, const XML_Char* s, int len)
+{
+    HangulKeyboardLoadContext* context = (HangulKeyboardLoadContext*)data;
+
+    if (context->keyboard == NULL)
+	return;
+
+    if (context->current_element != NULL && strcmp(context->current_element, "name") == 0) {
+	if (context->save_name) {
+	    char buf[1024];
+	    if (len >= sizeof(buf))
+		len = sizeof(buf) - 1;
+	    memcpy(buf, s, len);
+	    buf[len] = '\0';
+	    hangul_keyboard_set_name(context->keyboard, buf);
+	}
+    }
+}
+
+static void
+hangul_keyboard_parse_file(const char* path, HangulKeyboardLoadContext* context)
+{
+    int top = context->path_stack_top + 1;
+    if (top >= sizeof(context->path_stack) / sizeof(context->path_stack[0])) {
+        return;
+    }
+
+    context->path_stack[top] = path;
+    context->path_stack_top = top;
+
+    XML_Parser parser = XML_ParserCreate(NULL);
+    void* parent_parser = context->parser;
+    int parent_depth = context->depth;
+
+    context->parser = parser;
+    context->depth = 0;
+    XML_SetUserData(parser, context);
+    XML_SetElementHandler(parser, on_element_start, on_element_end);
+    XML_SetCharacterDataHandler(parser, on_char_data);
+
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        goto done;
+    }
+
+#ifdef HANGUL_KEYBOARD_CACHE
+    if (!context->header_only) {
+	struct stat st;
+	int n = context->nsources++;
+	if (n < HANGUL_KEYBOARD_MAX_SOURCES && fstat(fileno(file), &st) == 0) {
+	    context->sources[n].path = strdup(path);
+	    context->sources[n].mtime = st.st_mtime;
+	    context->sources[n].size = st.st_size;
+	}
+    }
+#endif /* HANGUL_KEYBOARD_CACHE */
+
+    /* include 한 파일은 내용의 해시로 이미 읽은 조합 파일인지 확인해야
+     * 하므로 한번에 읽는다. */
+    if (top > 0) {
+	char* content = NULL;
+	size_t len = 0;
+	size_t alloced = 0;
+
+	while (true) {
+	    if (len == alloced) {
+		char* p = realloc(content, alloced == 0 ? 8192 : alloced * 2);
+		if (p == NULL)
+		    break;
+		content = p;
+		alloced = alloced == 0 ? 8192 : alloced * 2;
+	    }
+	    size_t n = fread(content + len, 1, alloced - len, file);
+	    len += n;
+	    if (n == 0)
+		break;
+	}
+
+	if (content != NULL && feof(file)) {
+	    uint64_t content_hash = hangul_keyboard_content_hash(content, len);
+	    context->content_hash[top] = content_hash;
+	    if (!hangul_keyboard_include_combination(context, path, content_hash))
+		XML_Parse(parser, content, len, 1);
+	}
+	free(content);
+	goto close;
+    }
+
+    char buf[8192];
+
+    while (true) {
+	size_t n = fread(buf, 1, sizeof(buf), file);
+	int is_final = feof(file);
+	int res = XML_Parse(parser, buf, n, is_final);
+	if (res == XML_STATUS_ERROR) {
+	    goto close;
+	}
+	if (is_final || res == XML_STATUS_SUSPENDED)
+	    break;
+    }
+
+close:
+    fclose(file);
+done:
+    XML_ParserFree(parser);
+
+    context->parser = parent_parser;
+    context->depth = parent_depth;
+    context->path_stack_top--;
+}
+
+#ifdef HANGUL_KEYBOARD_CACHE
+/* 자판 파일 캐시
+ *
+ * XML 파일을 파싱한 결과를 $XDG_CACHE_HOME/libhangul/keyboards 에 자판
+ * 파일마다 하나씩 저장해 두고, 다음에는 XML 대신 캐시를 mmap 해서 읽는다.
+ * 캐시 파일 이름은 자판 파일 경로의 해시이고, 캐시에는 include 한 파일을
+ * 포함해서 읽은 파일들의 경로와 mtime, 크기를 기록해 두어서 하나라도
+ * 바뀌면 다시 파싱한다. 자판 이름은 로캘에 따라 달라지므로 로캘이 바뀌어도
+ * 다시 파싱한다.
+ * 캐시는 이 라이브러리만 읽으므로 정수는 기계의 바이트 순서대로 쓰고,
+ * 모든 항목은 8바이트 단위로 정렬한다. 헤더에는 헤더 뒤의 내용 전체의
+ * 해시를 적어 두어서, 쓰다 만 파일이나 깨진 파일은 읽지 않는다.
+ * include 한 조합 파일에서 읽은 조합 테이블은 그 파일의 경로와 내용의
+ * 해시도 같이 저장해 두었다가, 캐시에서 읽을 때 같은 파일에서 만든 조합
+ * 테이블이 이미 있으면 그것을 공유한다. */
+#define HANGUL_KEYBOARD_CACHE_MAGIC   "hkbcache"
+#define HANGUL_KEYBOARD_CACHE_VERSION 2
+
+typedef struct _HangulKeyboardCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t nsources;
+    int32_t type;
+    uint32_t tables;		/* 저장한 자판 테이블의 비트 */
+    uint32_t combinations;	/* 저장한 조합 테이블의 비트 */
+    uint32_t shared;		/* 조합 파일에서 읽어서 공유하는 조합 테이블의 비트 */
+    uint64_t checksum;		/* 헤더 뒤의 내용의 해시 */
+} HangulKeyboardCacheHeader;
+
+typedef struct _HangulKeyboardCacheCombination {
+    uint32_t size;
+    uint32_t hash_seed;
+    uint32_t hash_shift;
+    uint32_t hash_nslots;	/* 0이면 해시가 없다 */
+} HangulKeyboardCacheCombination;
+
+typedef struct _HangulKeyboardCacheBuffer {
+    char* data;
+    size_t len;
+    size_t alloced;
+    bool error;
+} HangulKeyboardCacheBuffer;
+
+typedef struct _HangulKeyboardCacheReader {
+    const char* data;
+    size_t len;
+    size_t pos;
+} HangulKeyboardCacheReader;
+
+static void
+hangul_keyboard_cache_append(HangulKeyboardCacheBuffer* buf,
+			     const void* data, size_t len)
+{
+    size_t padded = (len + 7) & ~(size_t)7;
+
+    if (buf->error)
+	return;
+
+    if (buf->len + padded > buf->alloced) {
+	size_t n = buf->alloced == 0 ? 4096 : buf->alloced;
+	while (n < buf->len + padded)
+	    n *= 2;
+	char* p = realloc(buf->data, n);
+	if (p == NULL) {
+	    buf->error = true;
+	    return;
+	}
+	buf->data = p;
+	buf->alloced = n;
+    }
+
+    memcpy(buf->data + buf->len, data, len);
+    memset(buf->data + buf->len + len, 0, padded - len);
+    buf->len += padded;
+}
+
+static void
+hangul_keyboard_cache_append_string(HangulKeyboardCacheBuffer* buf,
+				    const char* str)
+{
+    uint64_t len = str != NULL ? strlen(str) : 0;
+
+    hangul_keyboard_cache_append(buf, &len, sizeof(len));
+    hangul_keyboard_cache_append(buf, str != NULL ? str : "", len + 1);
+}
+
+static const void*
+hangul_keyboard_cache_read(HangulKeyboardCacheReader* reader, size_t len)
+{
+    size_t padded = (len + 7) & ~(size_t)7;
+    const void* p;
+
+    if (padded < len || reader->len - reader->pos < padded)
+	return NULL;
+
+    p = reader->data + reader->pos;
+    reader->pos += padded;
+    return p;
+}
+
+static const char*
+hangul_keyboard_cache_read_string(HangulKeyboardCacheReader* reader)
+{
+    const uint64_t* len = hangul_keyboard_cache_read(reader, sizeof(*len));
+    const char* str;
+
+    if (len == NULL || *len >= SIZE_MAX)
+	return NULL;
+
+    str = hangul_keyboard_cache_read(reader, *len + 1);
+    if (str == NULL || str[*len] != '\0')
+	return NULL;
+    return str;
+}
+
+static const char*
+hangul_keyboard_cache_get_locale()
+{
+    const char* locale = setlocale(LC_ALL, NULL);
+    return locale != NULL ? locale : "";
+}
+
+/* 캐시 디렉토리를 만들고 path 에 해당하는 캐시 파일 경로를 리턴한다. */
+static char*
+hangul_keyboard_cache_get_path(const char* path, bool create)
+{
+    const char* cache_home = getenv("XDG_CACHE_HOME");
+    const char* subdir = "/libhangul/keyboards";
+    char* cache_path;
+    size_t len;
+    uint64_t h = 14695981039346656037ull;
+    const char* p;
+
+    if (cache_home == NULL || cache_home[0] == '\0') {
+	cache_home = getenv("HOME");
+	if (cache_home == NULL || cache_home[0] == '\0')
+	    return NULL;
+	subdir = "/.cache/libhangul/keyboards";
+    }
+
+    for (p = path; *p != '\0'; ++p) {
+	h ^= (unsigned char)*p;
+	h *= 1099511628211ull;
+    }
+
+    len = strlen(cache_home) + strlen(subdir) + 1 + 16 + strlen(".cache") + 1;
+    cache_path = malloc(len);
+    if (cache_path == NULL)
+	return NULL;
+
+    snprintf(cache_path, len, "%s%s", cache_home, subdir);
+    if (create) {
+	/* 캐시 디렉토리가 아직 없을 수도 있으므로 앞에서부터 하나씩
+	 * 만든다. 이미 있으면 mkdir() 는 실패하지만 상관 없다. */
+	char* slash = cache_path;
+	while ((slash = strchr(slash + 1, '/')) != NULL) {
+	    *slash = '\0';
+	    mkdir(cache_path, 0700);
+	    *slash = '/';
+	}
+	mkdir(cache_path, 0700);
+    }
+
+    snprintf(cache_path, len, "%s%s/%016llx.cache",
+	     cache_home, subdir, (unsigned long long)h);
+    return cache_path;
+}
+
+static HangulKeyboard*
+hangul_keyboard_cache_parse(HangulKeyboardCacheReader* reader, const char* path)
+{
+    const HangulKeyboardCacheHeader* header;
+    const char* str;
+    HangulKeyboard* keyboard;
+    uint32_t i;
+
+    header = hangul_keyboard_cache_read(reader, sizeof(*header));
+    if (header == NULL ||
+	memcmp(header->magic, HANGUL_KEYBOARD_CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+	header->version != HANGUL_KEYBOARD_CACHE_VERSION)
+	return NULL;
+
+    if (header->checksum != hangul_keyboard_content_hash(
+		reader->data + reader->pos, reader->len - reader->pos))
+	return NULL;
+
+    str = hangul_keyboard_cache_read_string(reader);
+    if (str == NULL || strcmp(str, hangul_keyboard_cache_get_locale()) != 0)
+	return NULL;
+
+    /* 처음 파일은 자판 파일 자신이다. */
+    for (i = 0; i < header->nsources; ++i) {
+	const int64_t* stamp = hangul_keyboard_cache_read(reader, sizeof(int64_t) * 2);
+	struct stat st;
+
+	str = hangul_keyboard_cache_read_string(reader);
+	if (stamp == NULL || str == NULL)
+	    return NULL;
+	if (i == 0 && strcmp(str, path) != 0)
+	    return NULL;
+	if (stat(str, &st) != 0 || st.st_mtime != stamp[0] || st.st_size != stamp[1])
+	    return NULL;
+    }
+
+    keyboard = hangul_keyboard_new();
+    if (keyboard == NULL)
+	return NULL;
+
+    keyboard->type = header->type;
+    str = hangul_keyboard_cache_read_string(reader);
+    if (str == NULL)
+	goto fail;
+    hangul_keyboard_set_id(keyboard, str);
+    str = hangul_keyboard_cache_read_string(reader);
+    if (str == NULL)
+	goto fail;
+    if (str[0] != '\0')
+	hangul_keyboard_set_name(keyboard, str);
+
+    for (i = 0; i < countof(keyboard->table); ++i) {
+	const ucschar* table;
+	size_t size = sizeof(ucschar) * HANGUL_KEYBOARD_TABLE_SIZE;
+
+	if ((header->tables & (1 << i)) == 0)
+	    continue;
+
+	table = hangul_keyboard_cache_read(reader, size);
+	keyboard->table[i] = table != NULL ? malloc(size) : NULL;
+	if (keyboard->table[i] == NULL)
+	    goto fail;
+	memcpy(keyboard->table[i], table, size);
+    }
+
+    for (i = 0; i < countof(keyboard->combination); ++i) {
+	const HangulKeyboardCacheCombination* info;
+	const HangulCombinationItem* items;
+	const uint32_t* disp = NULL;
+	const HangulCombinationItem* slots = NULL;
+	const uint64_t* shared_hash = NULL;
+	const char* shared_path = NULL;
+	HangulCombination* combination;
+	size_t nbuckets = 0;
+
+	if ((header->combinations & (1 << i)) == 0)
+	    continue;
+
+	if (header->shared & (1 << i)) {
+	    shared_hash = hangul_keyboard_cache_read(reader, sizeof(*shared_hash));
+	    shared_path = hangul_keyboard_cache_read_string(reader);
+	    if (shared_hash == NULL || shared_path == NULL)
+		goto fail;
 	}
-    } else if (strcmp(element, "include") == 0) {
-	const char* file = attr_lookup(attr, "file");
-	if (file == NULL)
-	    return;
 
-        int top = context->path_stack_top;
-        if (top < 0)
-            return;
+	info = hangul_keyboard_cache_read(reader, sizeof(*info));
+	if (info == NULL || info->hash_shift == 0 || info->hash_shift > 31 ||
+	    (info->hash_nslots & (info->hash_nslots - 1)) != 0)
+	    goto fail;
 
-        size_t n = strlen(file) + strlen(context->path_stack[top]) + 1;
-	char* path = malloc(n);
-	if (path == NULL)
-	    return;
+	items = hangul_keyboard_cache_read(reader, info->size * sizeof(items[0]));
+	if (info->hash_nslots > 0) {
+	    nbuckets = (size_t)1 << (32 - info->hash_shift);
+	    disp = hangul_keyboard_cache_read(reader, nbuckets * sizeof(disp[0]));
+	    slots = hangul_keyboard_cache_read(reader, info->hash_nslots * sizeof(slots[0]));
+	}
+	if (items == NULL || (info->hash_nslots > 0 && (disp == NULL || slots == NULL)))
+	    goto fail;
+
+	if (shared_path != NULL) {
+	    HangulCombinationEntry* entry;
+	    entry = hangul_combination_entry_lookup(shared_path, *shared_hash);
+	    if (entry != NULL && entry->id == i) {
+		keyboard->combination[i] = hangul_combination_ref(entry->combination);
+		continue;
+	    }
+	}
 
-	if (file[0] == '/') {
-	    strncpy(path, file, n);
-	} else {
-	    char* orig_path = strdup(context->path_stack[top]);
-	    char* last_slash = strrchr(orig_path, '/');
-	    if (last_slash)
-		last_slash[0] = '\0';
+	combination = hangul_combination_new();
+	if (combination == NULL)
+	    goto fail;
+	keyboard->combination[i] = combination;
+
+	if (info->size > 0) {
+	    combination->table = malloc(info->size * sizeof(items[0]));
+	    if (combination->table == NULL)
+		goto fail;
+	    memcpy(combination->table, items, info->size * sizeof(items[0]));
+	    combination->size = info->size;
+	    combination->size_alloced = info->size;
+	}
 
-	    snprintf(path, n, "%s/%s", orig_path, file);
-	    free(orig_path);
+	if (info->hash_nslots > 0) {
+	    /* hangul_combination_build_hash() 와 같이 슬롯과 displacement 를
+	     * 한번에 할당한다. */
+	    HangulCombinationItem* hash_slots;
+	    uint32_t* hash_disp;
+
+	    hash_slots = malloc(info->hash_nslots * sizeof(hash_slots[0]) +
+				nbuckets * sizeof(hash_disp[0]));
+	    if (hash_slots == NULL)
+		goto fail;
+	    hash_disp = (uint32_t*)(hash_slots + info->hash_nslots);
+	    memcpy(hash_slots, slots, info->hash_nslots * sizeof(hash_slots[0]));
+	    memcpy(hash_disp, disp, nbuckets * sizeof(hash_disp[0]));
+
+	    combination->hash_seed = info->hash_seed;
+	    combination->hash_shift = info->hash_shift;
+	    combination->hash_mask = info->hash_nslots - 1;
+	    combination->hash_disp = hash_disp;
+	    combination->hash_slots = hash_slots;
 	}
 
-	hangul_keyboard_parse_file(path, context);
-	free(path);
+	if (shared_path != NULL)
+	    hangul_combination_entry_add(shared_path, *shared_hash, i, combination);
     }
+
+    return keyboard;
+
+fail:
+    hangul_keyboard_delete(keyboard);
+    return NULL;
 }
 
-static void XMLCALL
-on_element_end(void* data, const XML_Char* element)
+static HangulKeyboard*
+hangul_keyboard_cache_load(const char* path)
 {
-    HangulKeyboardLoadContext* context = (HangulKeyboardLoadContext*)data;
+    HangulKeyboardCacheReader reader;
+    HangulKeyboard* keyboard;
+    char* cache_path;
+    struct stat st;
+    void* data;
+    int fd;
 
-    if (context->keyboard == NULL)
-	return;
+    cache_path = hangul_keyboard_cache_get_path(path, false);
+    if (cache_path == NULL)
+	return NULL;
 
-    if (strcmp(element, "name") == 0) {
-	context->current_element = "";
-	context->save_name = false;
-    } else if (strcmp(element, "map") == 0) {
-	context->current_id = 0;
-	context->current_element = "";
-    } else if (strcmp(element, "combination") == 0) {
-	unsigned int id = context->current_id;
-	HangulCombination* combination = context->keyboard->combination[id];
-	hangul_combination_sort(combination);
-	context->current_id = 0;
-	context->current_element = "";
+    fd = open(cache_path, O_RDONLY);
+    free(cache_path);
+    if (fd < 0)
+	return NULL;
+
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+	close(fd);
+	return NULL;
     }
+
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+	return NULL;
+
+    reader.data = data;
+    reader.len = st.st_size;
+    reader.pos = 0;
+    keyboard = hangul_keyboard_cache_parse(&reader, path);
+
+    munmap(data, st.st_size);
+    return keyboard;
 }
 
-static void XMLCALL
-on_char_data(void* data, const XML_Char* s, int len)
+/* 다른 프로세스가 같은 캐시를 읽는 중일 수도 있으므로 임시 파일에
+ * 쓴 후에 이름을 바꾼다. 같은 자판을 여러 스레드나 프로세스가 동시에
+ * 저장할 수도 있으므로 임시 파일은 mkstemp() 로 겹치지 않게 만든다. */
+static void
+hangul_keyboard_cache_save(const char* path, const HangulKeyboard* keyboard,
+			   const HangulKeyboardLoadContext* context)
 {
-    HangulKeyboardLoadContext* context = (HangulKeyboardLoadContext*)data;
+    HangulKeyboardCacheHeader header;
+    HangulKeyboardCacheBuffer buf = { NULL, 0, 0, false };
+    const HangulCombinationEntry* shared[countof(keyboard->combination)];
+    char* cache_path;
+    char* tmp_path;
+    size_t len;
+    int i;
 
-    if (context->keyboard == NULL)
+    if (context->nsources == 0 || context->nsources > HANGUL_KEYBOARD_MAX_SOURCES)
 	return;
+    for (i = 0; i < context->nsources; ++i) {
+	if (context->sources[i].path == NULL)
+	    return;
+    }
 
-    if (context->current_element != NULL && strcmp(context->current_element, "name") == 0) {
-	if (context->save_name) {
-	    char buf[1024];
-	    if (len >= sizeof(buf))
-		len = sizeof(buf) - 1;
-	    memcpy(buf, s, len);
-	    buf[len] = '\0';
-	    hangul_keyboard_set_name(context->keyboard, buf);
-	}
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HANGUL_KEYBOARD_CACHE_MAGIC, sizeof(header.magic));
+    header.version = HANGUL_KEYBOARD_CACHE_VERSION;
+    header.nsources = context->nsources;
+    header.type = keyboard->type;
+    for (i = 0; i < countof(keyboard->table); ++i) {
+	if (keyboard->table[i] != NULL)
+	    header.tables |= 1 << i;
+    }
+    for (i = 0; i < countof(keyboard->combination); ++i) {
+	if (keyboard->combination[i] != NULL)
+	    header.combinations |= 1 << i;
+	shared[i] = hangul_combination_entry_find(i, keyboard->combination[i]);
+	if (shared[i] != NULL)
+	    header.shared |= 1 << i;
     }
-}
 
-static void
-hangul_keyboard_parse_file(const char* path, HangulKeyboardLoadContext* context)
-{
-    int top = context->path_stack_top + 1;
-    if (top >= sizeof(context->path_stack) / sizeof(context->path_stack[0])) {
-        return;
+    hangul_keyboard_cache_append(&buf, &header, sizeof(header));
+    hangul_keyboard_cache_append_string(&buf, hangul_keyboard_cache_get_locale());
+    for (i = 0; i < context->nsources; ++i) {
+	int64_t stamp[2] = { context->sources[i].mtime, context->sources[i].size };
+	hangul_keyboard_cache_append(&buf, stamp, sizeof(stamp));
+	hangul_keyboard_cache_append_string(&buf, context->sources[i].path);
     }
+    hangul_keyboard_cache_append_string(&buf, keyboard->id);
+    hangul_keyboard_cache_append_string(&buf, keyboard->name);
 
-    context->path_stack[top] = path;
-    context->path_stack_top = top;
+    for (i = 0; i < countof(keyboard->table); ++i) {
+	if (keyboard->table[i] != NULL)
+	    hangul_keyboard_cache_append(&buf, keyboard->table[i],
+		    sizeof(ucschar) * HANGUL_KEYBOARD_TABLE_SIZE);
+    }
 
-    XML_Parser parser = XML_ParserCreate(NULL);
+    for (i = 0; i < countof(keyboard->combination); ++i) {
+	const HangulCombination* combination = keyboard->combination[i];
+	HangulKeyboardCacheCombination info;
 
-    XML_SetUserData(parser, context);
-    XML_SetElementHandler(parser, on_element_start, on_element_end);
-    XML_SetCharacterDataHandler(parser, on_char_data);
+	if (combination == NULL)
+	    continue;
 
-    FILE* file = fopen(path, "r");
-    if (file == NULL) {
-        goto done;
+	if (shared[i] != NULL) {
+	    hangul_keyboard_cache_append(&buf, &shared[i]->content_hash,
+		    sizeof(shared[i]->content_hash));
+	    hangul_keyboard_cache_append_string(&buf, shared[i]->path);
+	}
+
+	memset(&info, 0, sizeof(info));
+	info.size = combination->size;
+	info.hash_seed = combination->hash_seed;
+	info.hash_shift = combination->hash_shift;
+	if (combination->hash_slots != NULL)
+	    info.hash_nslots = combination->hash_mask + 1;
+
+	hangul_keyboard_cache_append(&buf, &info, sizeof(info));
+	hangul_keyboard_cache_append(&buf, combination->table,
+		combination->size * sizeof(combination->table[0]));
+	if (info.hash_nslots > 0) {
+	    hangul_keyboard_cache_append(&buf, combination->hash_disp,
+		    ((size_t)1 << (32 - info.hash_shift)) * sizeof(uint32_t));
+	    hangul_keyboard_cache_append(&buf, combination->hash_slots,
+		    info.hash_nslots * sizeof(combination->hash_slots[0]));
+	}
     }
 
-    char buf[8192];
+    cache_path = hangul_keyboard_cache_get_path(path, true);
+    if (buf.error || cache_path == NULL) {
+	free(cache_path);
+	free(buf.data);
+	return;
+    }
 
-    while (true) {
-	size_t n = fread(buf, 1, sizeof(buf), file);
-	int is_final = feof(file);
-	int res = XML_Parse(parser, buf, n, is_final);
-	if (res == XML_STATUS_ERROR) {
-	    goto close;
+    header.checksum = hangul_keyboard_content_hash(buf.data + sizeof(header),
+						   buf.len - sizeof(header));
+    memcpy(buf.data, &header, sizeof(header));
+
+    len = strlen(cache_path) + 8;
+    tmp_path = malloc(len);
+    if (tmp_path != NULL) {
+	int fd;
+
+	snprintf(tmp_path, len, "%s.XXXXXX", cache_path);
+	fd = mkstemp(tmp_path);
+	if (fd >= 0) {
+	    size_t written = 0;
+	    while (written < buf.len) {
+		ssize_t n = write(fd, buf.data + written, buf.len - written);
+		if (n < 0 && errno == EINTR)
+		    continue;
+		if (n <= 0)
+		    break;
+		written += n;
+	    }
+	    close(fd);
+
+	    if (written != buf.len || rename(tmp_path, cache_path) != 0)
+		unlink(tmp_path);
 	}
-	if (is_final)
-	    break;
+	free(tmp_path);
     }
 
-close:
-    fclose(file);
-done:
-    XML_ParserFree(parser);
-
-    context->path_stack_top--;
+    free(cache_path);
+    free(buf.data);
 }
+#endif /* HANGUL_KEYBOARD_CACHE */
 
 HangulKeyboard*
 hangul_keyboard_new_from_file(const char* path)
 {
     HangulKeyboardLoadContext context;
+    int i;
+
+#ifdef HANGUL_KEYBOARD_CACHE
+    HangulKeyboard* keyboard = hangul_keyboard_cache_load(path);
+    if (keyboard != NULL)
+	return keyboard;
+#endif /* HANGUL_KEYBOARD_CACHE */
+
     memset(&context, 0, sizeof(context));
     context.path_stack_top = -1;
 
     hangul_keyboard_parse_file(path, &context);
 
+#ifdef HANGUL_KEYBOARD_CACHE
+    if (context.keyboard != NULL)
+	hangul_keyboard_cache_save(path, context.keyboard, &context);
+#endif /* HANGUL_KEYBOARD_CACHE */
+
+    for (i = 0; i < context.nsources && i < HANGUL_KEYBOARD_MAX_SOURCES; ++i)
+	free(context.sources[i].path);
+
     return context.keyboard;
 }
 
+/* 자판 파일의 앞부분에서 id와 이름, 종류만 읽어서 자판을 만든다.
+ * 나머지는 hangul_keyboard_load() 에서 읽는다. */
+static HangulKeyboard*
+hangul_keyboard_new_from_file_header(const char* path)
+{
+    HangulKeyboardLoadContext context;
+    memset(&context, 0, sizeof(context));
+    context.path_stack_top = -1;
+    context.header_only = true;
+
+    hangul_keyboard_parse_file(path, &context);
+
+    HangulKeyboard* keyboard = context.keyboard;
+    if (keyboard == NULL)
+	return NULL;
+
+    keyboard->path = strdup(path);
+    if (keyboard->path == NULL || keyboard->id == NULL) {
+	hangul_keyboard_delete(keyboard);
+	return NULL;
+    }
+
+    /* 이름이 없는 자판은 id 를 이름으로 쓴다. */
+    if (keyboard->name == NULL)
+	hangul_keyboard_set_name(keyboard, keyboard->id);
+
+    keyboard->load_state = HANGUL_KEYBOARD_PENDING;
+
+    return keyboard;
+}
+
+/* 아직 테이블을 읽지 않은 자판이면 자판 파일을 모두 읽어서 채운다.
+ * 다른 스레드가 같은 자판을 읽고 있으면 다 읽을 때까지 기다린다. */
+static bool
+hangul_keyboard_load(HangulKeyboard* keyboard)
+{
+    long state = hangul_keyboard_state_load(&keyboard->load_state);
+    size_t i;
+
+    if (state == HANGUL_KEYBOARD_LOADED)
+	return true;
+
+    if (hangul_keyboard_state_cas(&keyboard->load_state,
+				  HANGUL_KEYBOARD_PENDING, HANGUL_KEYBOARD_LOADING)) {
+	HangulKeyboard* loaded = hangul_keyboard_new_from_file(keyboard->path);
+	if (loaded == NULL) {
+	    hangul_keyboard_state_store(&keyboard->load_state,
+					HANGUL_KEYBOARD_LOAD_FAILED);
+	    return false;
+	}
+
+	for (i = 0; i < countof(keyboard->table); ++i) {
+	    keyboard->table[i] = loaded->table[i];
+	    loaded->table[i] = NULL;
+	}
+	for (i = 0; i < countof(keyboard->combination); ++i) {
+	    keyboard->combination[i] = loaded->combination[i];
+	    loaded->combination[i] = NULL;
+	}
+	hangul_keyboard_delete(loaded);
+
+	hangul_keyboard_touch(keyboard);
+	hangul_keyboard_state_store(&keyboard->load_state, HANGUL_KEYBOARD_LOADED);
+	return true;
+    }
+
+    while ((state = hangul_keyboard_state_load(&keyboard->load_state)) ==
+	   HANGUL_KEYBOARD_LOADING) {
+#ifdef _WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+    }
+
+    return state == HANGUL_KEYBOARD_LOADED;
+}
+
 static unsigned
 hangul_keyboard_list_load_dir(const char* path)
 {
@@ -819,14 +2053,23 @@ hangul_keyboard_list_load_dir(const char* path)
 	return 0;
     }
 
+    /* 디렉토리의 자판을 모아서 한번에 등록한다. */
+    HangulKeyboard** keyboards = malloc(result.gl_pathc * sizeof(keyboards[0]));
+    size_t n = 0;
     size_t i;
-    for (i = 0; i < result.gl_pathc; ++i) {
-	HangulKeyboard* keyboard = hangul_keyboard_new_from_file(result.gl_pathv[i]);
+    for (i = 0; keyboards != NULL && i < result.gl_pathc; ++i) {
+	HangulKeyboard* keyboard = hangul_keyboard_new_from_file_header(result.gl_pathv[i]);
 	if (keyboard == NULL)
 	    continue;
-	hangul_keyboard_list_append(keyboard);
+	keyboards[n++] = keyboard;
     }
 
+    if (n > 0 && !hangul_keyboard_list_append(keyboards, n)) {
+	for (i = 0; i < n; ++i)
+	    hangul_keyboard_delete(keyboards[i]);
+    }
+
+    free(keyboards);
     globfree(&result);
     free(pattern);
 #else /* _WIN32 */
@@ -865,12 +2108,13 @@ hangul_keyboard_list_load_dir(const char* path)
 	char* pfile = &file[path_len + 1];
 	WideCharToMultiByte(CP_ACP, 0, findFileData.cFileName, -1, pfile, n, NULL, NULL);
 
-	HangulKeyboard* keyboard = hangul_keyboard_new_from_file(file);
+	HangulKeyboard* keyboard = hangul_keyboard_new_from_file_header(file);
 	free(file);
 
 	if (keyboard == NULL)
 	    continue;
-	hangul_keyboard_list_append(keyboard);
+	if (!hangul_keyboard_list_append(&keyboard, 1))
+	    hangul_keyboard_delete(keyboard);
     } while(FindNextFileW(hFind, &findFileData));
 
     FindClose(hFind);
@@ -878,23 +2122,38 @@ hangul_keyboard_list_load_dir(const char* path)
     free(pattern);
 #endif /* HAVE_GLOB_H */
 
-    return hangul_keyboards.n;
+    unsigned count = hangul_keyboard_list_size(hangul_keyboard_list_acquire());
+    hangul_keyboard_list_release();
+    return count;
 }
 #endif /* ENABLE_EXTERNAL_KEYBOARDS */
 
+/* 다른 스레드가 목록을 사용하지 않을 때에만 불러야 한다. */
 static void
 hangul_keyboard_list_clear()
 {
+    HangulKeyboardList* list = hangul_keyboards;
     size_t i;
-    for (i = 0; i < hangul_keyboards.n; ++i) {
-	hangul_keyboard_delete(hangul_keyboards.keyboards[i]);
+
+    hangul_keyboards = NULL;
+    if (list != NULL) {
+	for (i = 0; i < list->n; ++i) {
+	    hangul_keyboard_delete(list->keyboards[i]);
+	}
+	free(list);
     }
 
-    free(hangul_keyboards.keyboards);
+    list = hangul_keyboards_retired;
+    hangul_keyboards_retired = NULL;
+    while (list != NULL) {
+	HangulKeyboardList* next = list->retired;
+	free(list);
+	list = next;
+    }
 
-    hangul_keyboards.n = 0;
-    hangul_keyboards.nalloced = 0;
-    hangul_keyboards.keyboards = NULL;
+#if ENABLE_EXTERNAL_KEYBOARDS
+    hangul_combination_entry_clear();
+#endif /* ENABLE_EXTERNAL_KEYBOARDS */
 }
 
 #if ENABLE_EXTERNAL_KEYBOARDS
@@ -995,7 +2254,9 @@ hangul_keyboard_list_init(const char* user_defined_keyboard_path)
     /* 이 함수를 중복 호출할 경우에 대한 처리
      * 이미 등록된 자판이 있다면 중복 호출된 것으로 보고
      * 함수를 종료한다. */
-    if (hangul_keyboards.n > 0)
+    size_t registered = hangul_keyboard_list_size(hangul_keyboard_list_acquire());
+    hangul_keyboard_list_release();
+    if (registered > 0)
 	return 2;
 
     /* libhangul data dir에서 keyboard 로딩 */
@@ -1077,16 +2338,14 @@ hangul_builtin_keyboard_list_get_keyboard_name(unsigned index_)
 }
 
 static const HangulKeyboard*
-hangul_builtin_keyboard_list_get_keyboard(const char* id)
+hangul_builtin_keyboard_list_get_keyboard(const char* id, uint32_t hash)
 {
-    size_t i;
-    for (i = hangul_builtin_keyboard_count; i > 0; --i) {
-        const HangulKeyboard* keyboard = hangul_builtin_keyboards[i - 1];
-        if (strcmp(id, keyboard->id) == 0) {
-            return keyboard;
-        }
-    }
-    return NULL;
+    int i = hangul_keyboard_index_lookup(hangul_builtin_keyboard_index,
+					     hangul_builtin_keyboard_index_mask,
+					     hangul_builtin_keyboards, id, hash);
+    if (i < 0)
+	return NULL;
+    return hangul_builtin_keyboards[i];
 }
 
 /**
@@ -1095,13 +2354,17 @@ hangul_builtin_keyboard_list_get_keyboard(const char* id)
  *
  * 이 함수의 리턴값을 이용해서 자판을 iteration할 수 있다.
  * 한글 자판의 설치 위치에 대한 정보는 @ref addinghangulkeyboards 를 참고하라.
+ * 자판 목록을 읽는 함수들은 lock 없이 동작하므로 다른 스레드에서
+ * 자판을 등록하거나 삭제하는 중에도 부를 수 있다. 다만 그 사이에 목록이
+ * 바뀌면 iteration 도중에 개수가 달라질 수 있다.
  * @return @ref HangulInputContext 에서 선택 가능한 자판 개수
  */
 unsigned int
 hangul_keyboard_list_get_count()
 {
     unsigned int n = hangul_builtin_keyboard_count;
-    n += hangul_keyboards.n;
+    n += hangul_keyboard_list_size(hangul_keyboard_list_acquire());
+    hangul_keyboard_list_release();
 
     return n;
 }
@@ -1122,15 +2385,15 @@ hangul_keyboard_list_get_keyboard_id(unsigned index_)
         return hangul_builtin_keyboard_list_get_keyboard_id(index_);
     }
 
-    index_ -= hangul_builtin_keyboard_count;
-    if (index_ >= hangul_keyboards.n)
-	return NULL;
+    const HangulKeyboardList* list = hangul_keyboard_list_acquire();
+    const char* id = NULL;
 
-    HangulKeyboard* keyboard = hangul_keyboards.keyboards[index_];
-    if (keyboard == NULL)
-	return NULL;
+    index_ -= hangul_builtin_keyboard_count;
+    if (index_ < hangul_keyboard_list_size(list))
+	id = list->keyboards[index_]->id;
 
-    return keyboard->id;
+    hangul_keyboard_list_release();
+    return id;
 }
 
 /**
@@ -1149,15 +2412,15 @@ hangul_keyboard_list_get_keyboard_name(unsigned index_)
         return hangul_builtin_keyboard_list_get_keyboard_name(index_);
     }
 
-    index_ -= hangul_builtin_keyboard_count;
-    if (index_ >= hangul_keyboards.n)
-	return NULL;
+    const HangulKeyboardList* list = hangul_keyboard_list_acquire();
+    const char* name = NULL;
 
-    HangulKeyboard* keyboard = hangul_keyboards.keyboards[index_];
-    if (keyboard == NULL)
-	return NULL;
+    index_ -= hangul_builtin_keyboard_count;
+    if (index_ < hangul_keyboard_list_size(list))
+	name = list->keyboards[index_]->name;
 
-    return keyboard->name;
+    hangul_keyboard_list_release();
+    return name;
 }
 
 /**
@@ -1165,46 +2428,123 @@ hangul_keyboard_list_get_keyboard_name(unsigned index_)
  * @brief libhangul에서 제공하는 자판의 HangulKeyboard 포인터를 구하는 함수
  * @return id로 찾아진 자판의 HangulKeyboard 포인터, 못찾으면 NULL.
  *         이 스트럭처는 libhangul 내부에서 관리하는 것으로 free해서는 안된다.
+ *
+ * 자판 id의 해시 테이블에서 찾으므로 등록된 자판 개수와 관계 없이 빠르게
+ * 찾는다. 자판을 자주 바꾸는 경우에는 이 함수로 구한 포인터를 보관해 두었다가
+ * hangul_ic_set_keyboard() 로 설정하면 id를 찾는 과정도 생략할 수 있다.
  */
 const HangulKeyboard*
 hangul_keyboard_list_get_keyboard(const char* id)
 {
+    const HangulKeyboardList* list;
     const HangulKeyboard* keyboard = NULL;
+    uint32_t hash;
+    int i;
+
+    if (id == NULL)
+	return NULL;
 
-    /* 키보드 목록에서 역순으로 검색을 하여 마지막에 등록된 자판이
+    /* 같은 id의 자판이 여러개 등록되어 있으면 마지막에 등록된 자판이
      * 먼저 인식 된다. */
-    for (size_t i = hangul_keyboards.n; i > 0; --i) {
-        keyboard = hangul_keyboards.keyboards[i - 1];
-        if (strcmp(id, keyboard->id) == 0) {
-            return keyboard;
-        }
+    hash = hangul_keyboard_id_hash(id);
+    list = hangul_keyboard_list_acquire();
+    if (list != NULL) {
+	i = hangul_keyboard_index_lookup(list->index, list->index_mask,
+		(const HangulKeyboard* const*)list->keyboards, id, hash);
+	if (i >= 0)
+	    keyboard = list->keyboards[i];
+#if ENABLE_EXTERNAL_KEYBOARDS
+	/* 자판 파일에서 읽은 자판은 처음 선택할 때 테이블을 읽는다. */
+	if (keyboard != NULL && !hangul_keyboard_load(list->keyboards[i]))
+	    keyboard = NULL;
+#endif /* ENABLE_EXTERNAL_KEYBOARDS */
     }
+    hangul_keyboard_list_release();
 
     /* 등록된 자판 중에 없으면 builtin 자판을 찾아본다. */
-    keyboard = hangul_builtin_keyboard_list_get_keyboard(id);
+    if (keyboard == NULL)
+	keyboard = hangul_builtin_keyboard_list_get_keyboard(id, hash);
     return keyboard;
 }
 
+/* first 부터 last 까지 연결된 목록들을 retired 에 붙인다. */
+static void
+hangul_keyboard_list_retire(HangulKeyboardList* first, HangulKeyboardList* last)
+{
+    HangulKeyboardList* retired;
+
+    do {
+	retired = hangul_keyboard_list_load(&hangul_keyboards_retired);
+	last->retired = retired;
+    } while (!hangul_keyboard_list_cas(&hangul_keyboards_retired,
+				       retired, first));
+}
+
+/* list 를 새 목록으로 공개한다. 그 사이에 다른 스레드가 목록을 바꾸었으면
+ * list 를 해제하고 false를 리턴하므로 처음부터 다시 만들어야 한다.
+ * old 가 해제되지 않도록 hangul_keyboard_list_acquire() 로 old 를 구한
+ * 상태에서 불러야 한다. */
 static bool
-hangul_keyboard_list_append(HangulKeyboard* keyboard)
+hangul_keyboard_list_publish(HangulKeyboardList* old, HangulKeyboardList* list)
 {
-    if (hangul_keyboards.n >= hangul_keyboards.nalloced) {
-	size_t n = hangul_keyboards.nalloced * 2;
-	if (n == 0) {
-	    n = 16;
+    HangulKeyboardList* retired;
+
+    if (!hangul_keyboard_list_cas(&hangul_keyboards, old, list)) {
+	free(list);
+	return false;
+    }
+
+    if (old != NULL)
+	hangul_keyboard_list_retire(old, old);
+
+    /* 떼어낸 목록들은 그 전에 교체된 것이므로, 이 스레드 말고는 읽는
+     * 스레드가 없으면 그 목록을 가진 스레드도 없다. */
+    retired = hangul_keyboard_list_exchange(&hangul_keyboards_retired, NULL);
+    if (retired == NULL)
+	return true;
+
+    if (hangul_keyboard_list_readers() == 1) {
+	while (retired != NULL) {
+	    HangulKeyboardList* next = retired->retired;
+	    free(retired);
+	    retired = next;
 	}
-	HangulKeyboard** keyboards = hangul_keyboards.keyboards;
-	keyboards = realloc(keyboards, n * sizeof(keyboards[0]));
-	if (keyboards == NULL)
+    } else {
+	HangulKeyboardList* last = retired;
+	while (last->retired != NULL)
+	    last = last->retired;
+	hangul_keyboard_list_retire(retired, last);
+    }
+
+    return true;
+}
+
+static bool
+hangul_keyboard_list_append(HangulKeyboard** keyboards, size_t n)
+{
+    HangulKeyboardList* old;
+    HangulKeyboardList* list;
+    bool published;
+    size_t size;
+
+    do {
+	old = (HangulKeyboardList*)hangul_keyboard_list_acquire();
+	size = hangul_keyboard_list_size(old);
+
+	list = hangul_keyboard_list_new(size + n);
+	if (list == NULL) {
+	    hangul_keyboard_list_release();
 	    return false;
+	}
 
-	hangul_keyboards.nalloced = n;
-	hangul_keyboards.keyboards = keyboards;
-    }
+	if (size > 0)
+	    memcpy(list->keyboards, old->keyboards, size * sizeof(list->keyboards[0]));
+	memcpy(list->keyboards + size, keyboards, n * sizeof(list->keyboards[0]));
+	hangul_keyboard_list_build_index(list);
 
-    size_t i = hangul_keyboards.n;
-    hangul_keyboards.keyboards[i] = keyboard;
-    hangul_keyboards.n = i + 1;
+	published = hangul_keyboard_list_publish(old, list);
+	hangul_keyboard_list_release();
+    } while (!published);
 
     return true;
 }
@@ -1218,14 +2558,16 @@ hangul_keyboard_list_append(HangulKeyboard* keyboard)
  * 여기에 등록된 키보드는 hangul_ic_select()를 통해서 선택될 수 있게 된다.
  * 이후 @a keyboard 는 libhangul이 관리하므로 사용자가 임의로 삭제해서는 안된다.
  * hangul_fini() 함수 안에서 삭제될 것이다.
+ * 다른 스레드가 자판을 선택하는 중에 불러도 된다. id가 없는 자판은
+ * 등록할 수 없다.
  */
 const char*
 hangul_keyboard_list_register_keyboard(HangulKeyboard* keyboard)
 {
-    if (keyboard == NULL)
+    if (keyboard == NULL || keyboard->id == NULL)
         return NULL;
 
-    bool res = hangul_keyboard_list_append(keyboard);
+    bool res = hangul_keyboard_list_append(&keyboard, 1);
     if (!res) {
         return NULL;
     }
@@ -1239,30 +2581,51 @@ hangul_keyboard_list_register_keyboard(HangulKeyboard* keyboard)
  * @param id 삭제할 키보드 id
  * @return 리스트에서 삭제된 HangulKeyboard 의 포인터, 이 포인터는 더이상 libhangul에서
  *         관리하지 않으므로 사용자가 hangul_keyboard_delete() 함수로 삭제해야 한다.
+ *
+ * 다른 스레드에서 불러도 목록을 읽는 쪽은 영향을 받지 않는다. 그러나 이미
+ * 이 자판을 선택한 @ref HangulInputContext 는 계속 사용하므로, 그런 입력
+ * 상태가 없을 때 자판을 삭제해야 한다.
  */
 HangulKeyboard*
 hangul_keyboard_list_unregister_keyboard(const char* id)
 {
-    HangulKeyboard* keyboard = NULL;
-
+    HangulKeyboardList* old;
+    HangulKeyboardList* list;
+    HangulKeyboard* keyboard;
+    bool published;
+    size_t size;
     size_t i;
-    for (i = 0; i < hangul_keyboards.n; ++i) {
-        keyboard = hangul_keyboards.keyboards[i];
-        if (strcmp(id, keyboard->id) == 0) {
-            break;
-        }
-    }
 
-    if (keyboard == NULL) {
-        return NULL;
-    }
+    if (id == NULL)
+	return NULL;
 
-    for (++i; i < hangul_keyboards.n; ++i) {
-        hangul_keyboards.keyboards[i - 1] = hangul_keyboards.keyboards[i];
-    }
+    do {
+	old = (HangulKeyboardList*)hangul_keyboard_list_acquire();
+	size = hangul_keyboard_list_size(old);
+
+	for (i = 0; i < size; ++i) {
+	    if (strcmp(id, old->keyboards[i]->id) == 0)
+		break;
+	}
+
+	list = NULL;
+	if (i < size)
+	    list = hangul_keyboard_list_new(size - 1);
+	if (list == NULL) {
+	    hangul_keyboard_list_release();
+	    return NULL;
+	}
+
+	keyboard = old->keyboards[i];
+
+	memcpy(list->keyboards, old->keyboards, i * sizeof(list->keyboards[0]));
+	memcpy(list->keyboards + i, old->keyboards + i + 1,
+	       (size - i - 1) * sizeof(list->keyboards[0]));
+	hangul_keyboard_list_build_index(list);
 
-    hangul_keyboards.keyboards[i - 1] = NULL;
-    hangul_keyboards.n--;
+	published = hangul_keyboard_list_publish(old, list);
+	hangul_keyboard_list_release();
+    } while (!published);
 
     return keyboard;
 }
@@ -149,6 +149,11 @@
  * 
  * 그 내용은 키값에 대해서 sorting 되어야 있어야 한다.
  * 파일의 인코딩은 UTF-8이어야 한다.
+ *
+ * 한자 사전은 열어 둔 사전 파일 하나를 검색할 때와 설명을 읽을 때 같이
+ * 사용하므로, 한 사전과 그 사전에서 검색한 @ref HanjaList 는 동시에 한
+ * 스레드에서만 사용해야 한다. 여러 스레드에서 검색할 때에는 스레드마다
+ * 사전을 로딩하거나 lock 을 사용한다.
  */
 
 typedef struct _HanjaIndex     HanjaIndex;
@@ -159,7 +164,15 @@ typedef struct _HanjaPairArray HanjaPairArray;
 struct _Hanja {
     uint32_t key_offset;
     uint32_t value_offset;
-    uint32_t comment_offset;
+
+    /* comment는 대부분 레코드에서 가장 큰 필드지만, 후보창에서는
+     * 선택된 아이템에 대해서만 참조한다. 그래서 검색할 때에는 파일상의
+     * 위치만 기억해 두고, hanja_get_comment()가 불릴때 읽는다.
+     * 위치는 읽은 줄의 길이를 더해서 구하므로 사전 파일은 바이너리 모드로
+     * 열어야 한다. 텍스트 모드에서는 CRLF 변환 때문에 위치가 맞지 않는다. */
+    long          comment_pos;
+    HanjaTable*   table;
+    char*         comment;
 };
 
 struct _HanjaList {
@@ -167,6 +180,7 @@ struct _HanjaList {
     size_t        len;
     size_t        alloc;
     const Hanja** items; 
+    HanjaTable*   table;
 };
 
 struct _HanjaIndex {
@@ -174,11 +188,16 @@ struct _HanjaIndex {
     char     key[8];
 };
 
+#define HANJA_TABLE_N_STATS (HANJA_TABLE_STATS_COMMENT_LOADS + 1)
+
 struct _HanjaTable {
     HanjaIndex*    keytable;
     unsigned       nkeys;
     unsigned       key_size;
     FILE*          file;
+    unsigned       ref;
+
+    unsigned long  stats[HANJA_TABLE_N_STATS];
 };
 
 struct _HanjaPair {
@@ -232,25 +251,48 @@ static inline char* utf8_prev(const char *str, const char *p)
     return (char*)p;
 }
 
+static HanjaTable*
+hanja_table_ref(const HanjaTable* table)
+{
+    HanjaTable* t = (HanjaTable*)table;
+    t->ref++;
+    return t;
+}
+
+/* 검색 함수들은 const HanjaTable* 를 받지만 통계값은 갱신해야 하므로
+ * 여기서 const를 제거한다. */
+static inline unsigned long*
+hanja_table_stats(const HanjaTable* table)
+{
+    return ((HanjaTable*)table)->stats;
+}
+
+static void
+hanja_table_unref(HanjaTable* table)
+{
+    table->ref--;
+    if (table->ref == 0) {
+	free(table->keytable);
+	fclose(table->file);
+	free(table);
+    }
+}
+
 /* hanja searching functions */
 static Hanja *
-hanja_new(const char *key, const char *value, const char *comment)
+hanja_new(const char *key, const char *value,
+	  HanjaTable* table, long comment_pos)
 {
     Hanja* hanja;
     size_t size;
     size_t keylen;
     size_t valuelen;
-    size_t commentlen;
     char*  p;
 
     keylen = strlen(key) + 1;
     valuelen = strlen(value) + 1;
-    if (comment != NULL)
-	commentlen = strlen(comment) + 1;
-    else
-	commentlen = 1;
 
-    size = sizeof(*hanja) + keylen + valuelen + commentlen;
+    size = sizeof(*hanja) + keylen + valuelen;
     hanja = malloc(size);
     if (hanja == NULL)
 	return NULL;
@@ -259,16 +301,12 @@ hanja_new(const char *key, const char *value, const char *comment)
     strcpy(p, key);
     p += keylen;
     strcpy(p, value);
-    p += valuelen;
-    if (comment != NULL)
-	strcpy(p, comment);
-    else
-	*p = '\0';
-    p += valuelen;
 
     hanja->key_offset     = sizeof(*hanja);
     hanja->value_offset   = sizeof(*hanja) + keylen;
-    hanja->comment_offset = sizeof(*hanja) + keylen + valuelen;
+    hanja->comment_pos    = comment_pos;
+    hanja->table          = table;
+    hanja->comment        = NULL;
 
     return hanja;
 }
@@ -276,9 +314,41 @@ hanja_new(const char *key, const char *value, const char *comment)
 static void
 hanja_delete(Hanja* hanja)
 {
+    free(hanja->comment);
     free(hanja);
 }
 
+static const char*
+hanja_load_comment(Hanja* hanja)
+{
+    char buf[512];
+    char* p;
+    FILE* file;
+
+    if (hanja->comment_pos < 0 || hanja->table == NULL)
+	return "";
+
+    file = hanja->table->file;
+    if (fseek(file, hanja->comment_pos, SEEK_SET) != 0)
+	return "";
+
+    if (fgets(buf, sizeof(buf), file) == NULL)
+	return "";
+
+    hanja->table->stats[HANJA_TABLE_STATS_COMMENT_LOADS]++;
+    hanja->table->stats[HANJA_TABLE_STATS_BYTES_READ] += strlen(buf);
+
+    p = strpbrk(buf, "\r\n");
+    if (p != NULL)
+	*p = '\0';
+
+    hanja->comment = strdup(buf);
+    if (hanja->comment == NULL)
+	return "";
+
+    return hanja->comment;
+}
+
 /**
  * @ingroup hanjadictionary
  * @brief @ref Hanja 의 키를 찾아본다.
@@ -324,6 +394,10 @@ hanja_get_value(const Hanja* hanja)
  *
  * 일반적으로 @ref Hanja 아이템의 설명은 한글과 그 한자에 대한 설명이다.
  * 파일에 따라서 내용이 없을 수 있다.
+ * 설명은 검색할 때 미리 읽어 두지 않고 이 함수를 처음 부를 때 사전 파일에서
+ * 읽어온다. 따라서 @a hanja 가 const 이더라도 이 함수는 사전 파일을 읽고
+ * @a hanja 를 바꾸므로, 같은 사전에서 검색한 결과를 여러 스레드에서 동시에
+ * 사용하면 안된다.
  * 리턴되는 스트링은 @a hanja 오브젝트 내부적으로 관리하는 데이터로
  * 수정하거나 free되어서는 안된다.
  */
@@ -331,14 +405,15 @@ const char*
 hanja_get_comment(const Hanja* hanja)
 {
     if (hanja != NULL) {
-	const char* p  = (const char*)hanja;
-	return p + hanja->comment_offset;
+	if (hanja->comment != NULL)
+	    return hanja->comment;
+	return hanja_load_comment((Hanja*)hanja);
     }
     return NULL;
 }
 
 static HanjaList *
-hanja_list_new(const char *key)
+hanja_list_new(const char *key, const HanjaTable* table)
 {
     HanjaList *list;
 
@@ -361,6 +436,8 @@ hanja_list_new(const char *key)
 	return NULL;
     }
 
+    list->table = hanja_table_ref(table);
+
     return list;
 }
 
@@ -402,10 +479,13 @@ hanja_list_append_n(HanjaList* list, const Hanja* hanja, int n)
     }
 }
 
-static void
+/* 검색한 레코드의 수를 리턴한다. */
+static unsigned long
 hanja_table_match(const HanjaTable* table,
 		  const char* key, HanjaList** list)
 {
+    unsigned long* stats = hanja_table_stats(table);
+    unsigned long nscanned = 0;
     int low, high, mid;
     int res = -1;
 
@@ -413,6 +493,7 @@ hanja_table_match(const HanjaTable* table,
     high = table->nkeys - 1;
 
     while (low < high) {
+	stats[HANJA_TABLE_STATS_INDEX_PROBES]++;
 	mid = (low + high) / 2;
 	res = strncmp(table->keytable[mid].key, key, table->key_size);
 	if (res < 0) {
@@ -430,19 +511,26 @@ hanja_table_match(const HanjaTable* table,
     }
 
     if (res == 0) {
-	unsigned offset;
+	long offset;
 	char buf[512];
 
 	offset = table->keytable[mid].offset;
 	fseek(table->file, offset, SEEK_SET);
 
 	while (fgets(buf, sizeof(buf), table->file) != NULL) {
+	    long line_offset = offset;
 	    char* save = NULL;
-	    char* p = strtok_r(buf, ":", &save);
+	    char* p;
+
+	    offset += strlen(buf);
+	    stats[HANJA_TABLE_STATS_BYTES_READ] += strlen(buf);
+	    nscanned++;
+
+	    p = strtok_r(buf, ":", &save);
 	    res = strcmp(p, key);
 	    if (res == 0) {
                 if (*list == NULL) {
-                    *list = hanja_list_new(key);
+                    *list = hanja_list_new(key, table);
                 }
 
                 if (*list == NULL) {
@@ -450,16 +538,39 @@ hanja_table_match(const HanjaTable* table,
                 }
 
 		char* value   = strtok_r(NULL, ":", &save);
-		char* comment = strtok_r(NULL, "\r\n", &save);
+		if (value == NULL)
+		    continue;
+
+		/* comment는 여기서 복사하지 않고 위치만 기록해 둔다 */
+		long comment_pos = -1;
+		if (save != NULL && *save != '\0' &&
+		    *save != '\r' && *save != '\n')
+		    comment_pos = line_offset + (save - buf);
 
-		Hanja* hanja = hanja_new(p, value, comment);
+		Hanja* hanja = hanja_new(p, value, (*list)->table, comment_pos);
+		if (hanja == NULL)
+		    continue;
 
 		hanja_list_append_n(*list, hanja, 1);
+		stats[HANJA_TABLE_STATS_RESULTS]++;
 	    } else if (res > 0) {
 		break;
 	    }
 	}
     }
+
+    stats[HANJA_TABLE_STATS_RECORDS_SCANNED] += nscanned;
+
+    return nscanned;
+}
+
+static void
+hanja_table_update_max_scanned(const HanjaTable* table, unsigned long n)
+{
+    unsigned long* stats = hanja_table_stats(table);
+
+    if (n > stats[HANJA_TABLE_STATS_MAX_RECORDS_SCANNED])
+	stats[HANJA_TABLE_STATS_MAX_RECORDS_SCANNED] = n;
 }
 
 /**
@@ -501,7 +612,7 @@ hanja_table_load(const char* filename)
 	return NULL;
 #endif /* LIBHANGUL_DEFAULT_HANJA_DIC */
 
-    file = fopen(filename, "r");
+    file = fopen(filename, "rb");
     if (file == NULL) {
 	return NULL;
     }
@@ -561,6 +672,8 @@ hanja_table_load(const char* filename)
     table->nkeys = nkeys;
     table->key_size = key_size;
     table->file = file;
+    table->ref = 1;
+    memset(table->stats, 0, sizeof(table->stats));
 
     return table;
 }
@@ -569,14 +682,15 @@ hanja_table_load(const char* filename)
  * @ingroup hanjadictionary
  * @brief 한자 사전 object를 free하는 함수
  * @param table free할 한자 사전 object
+ *
+ * 이 사전에서 검색한 @ref HanjaList 가 아직 남아 있으면 사전 파일은
+ * 마지막 @ref HanjaList 가 삭제될 때 닫힌다.
  */
 void
 hanja_table_delete(HanjaTable *table)
 {
     if (table != NULL) {
-	free(table->keytable);
-	fclose(table->file);
-	free(table);
+	hanja_table_unref(table);
     }
 }
 
@@ -596,11 +710,15 @@ HanjaList*
 hanja_table_match_exact(const HanjaTable* table, const char *key)
 {
     HanjaList* ret = NULL;
+    unsigned long n;
 
     if (key == NULL || key[0] == '\0' || table == NULL)
 	return NULL;
 
-    hanja_table_match(table, key, &ret);
+    hanja_table_stats(table)[HANJA_TABLE_STATS_EXACT_LOOKUPS]++;
+
+    n = hanja_table_match(table, key, &ret);
+    hanja_table_update_max_scanned(table, n);
 
     return ret;
 }
@@ -626,6 +744,7 @@ hanja_table_match_prefix(const HanjaTable* table, const char *key)
     char* p;
     char* newkey;
     HanjaList* ret = NULL;
+    unsigned long n = 0;
 
     if (key == NULL || key[0] == '\0' || table == NULL)
 	return NULL;
@@ -634,14 +753,18 @@ hanja_table_match_prefix(const HanjaTable* table, const char *key)
     if (newkey == NULL)
 	return NULL;
 
+    hanja_table_stats(table)[HANJA_TABLE_STATS_PREFIX_LOOKUPS]++;
+
     p = strchr(newkey, '\0');
     while (newkey[0] != '\0') {
-	hanja_table_match(table, newkey, &ret);
+	n += hanja_table_match(table, newkey, &ret);
 	p = utf8_prev(newkey, p);
 	p[0] = '\0';
     }
     free(newkey);
 
+    hanja_table_update_max_scanned(table, n);
+
     return ret;
 }
 
@@ -665,19 +788,79 @@ hanja_table_match_suffix(const HanjaTable* table, const char *key)
 {
     const char* p;
     HanjaList* ret = NULL;
+    unsigned long n = 0;
 
     if (key == NULL || key[0] == '\0' || table == NULL)
 	return NULL;
 
+    hanja_table_stats(table)[HANJA_TABLE_STATS_SUFFIX_LOOKUPS]++;
+
     p = key;
     while (p[0] != '\0') {
-	hanja_table_match(table, p, &ret);
+	n += hanja_table_match(table, p, &ret);
 	p = utf8_next(p);
     }
 
+    hanja_table_update_max_scanned(table, n);
+
     return ret;
 }
 
+/**
+ * @ingroup hanjadictionary
+ * @brief 한자 사전의 검색 통계값을 구하는 함수
+ * @param table 한자 사전 object
+ * @param item 구하고자 하는 통계 항목. 아래와 같은 값을 사용할 수 있다.
+ *    - HANJA_TABLE_STATS_EXACT_LOOKUPS
+ *      - hanja_table_match_exact() 호출 횟수
+ *    - HANJA_TABLE_STATS_PREFIX_LOOKUPS
+ *      - hanja_table_match_prefix() 호출 횟수
+ *    - HANJA_TABLE_STATS_SUFFIX_LOOKUPS
+ *      - hanja_table_match_suffix() 호출 횟수
+ *    - HANJA_TABLE_STATS_INDEX_PROBES
+ *      - 키 인덱스를 이진 탐색하면서 비교한 횟수
+ *    - HANJA_TABLE_STATS_BYTES_READ
+ *      - 사전 파일에서 읽은 바이트 수
+ *    - HANJA_TABLE_STATS_RECORDS_SCANNED
+ *      - 검색하면서 읽어본 레코드(라인)의 수
+ *    - HANJA_TABLE_STATS_MAX_RECORDS_SCANNED
+ *      - 검색 함수 한번 호출에서 읽은 레코드 수의 최대값
+ *    - HANJA_TABLE_STATS_RESULTS
+ *      - 검색 결과로 리턴한 @ref Hanja 아이템의 수
+ *    - HANJA_TABLE_STATS_COMMENT_LOADS
+ *      - hanja_get_comment() 에서 설명을 사전 파일에서 읽어온 횟수
+ * @return 테이블을 로딩하거나 hanja_table_reset_stats() 를 부른 이후
+ *         누적된 값
+ *
+ * 특정 검색이 느린 원인을 찾을 때 프로파일러 없이 확인할 수 있도록
+ * 내부 동작 횟수를 세어 둔다.
+ */
+unsigned long
+hanja_table_get_stats(const HanjaTable* table, int item)
+{
+    if (table == NULL)
+	return 0;
+
+    if (item < 0 || item >= HANJA_TABLE_N_STATS)
+	return 0;
+
+    return table->stats[item];
+}
+
+/**
+ * @ingroup hanjadictionary
+ * @brief 한자 사전의 검색 통계값을 0으로 초기화하는 함수
+ * @param table 한자 사전 object
+ */
+void
+hanja_table_reset_stats(HanjaTable* table)
+{
+    if (table == NULL)
+	return;
+
+    memset(table->stats, 0, sizeof(table->stats));
+}
+
 /**
  * @ingroup hanjadictionary
  * @brief @ref HanjaList 가 가지고 있는 아이템의 갯수를 구하는 함수
@@ -813,6 +996,7 @@ hanja_list_delete(HanjaList *list)
 	}
 	free(list->items);
 	free(list->key);
+	hanja_table_unref(list->table);
 	free(list);
     }
 }
@@ -0,0 +1,30 @@
+#include "alloccounter.h"
+
+unsigned long n_allocs = 0;
+
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t nmemb, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+void*
+malloc(size_t size)
+{
+    n_allocs++;
+    return __libc_malloc(size);
+}
+
+void*
+calloc(size_t nmemb, size_t size)
+{
+    n_allocs++;
+    return __libc_calloc(nmemb, size);
+}
+
+void*
+realloc(void* ptr, size_t size)
+{
+    n_allocs++;
+    return __libc_realloc(ptr, size);
+}
+#endif /* __GLIBC__ */
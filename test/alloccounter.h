@@ -0,0 +1,18 @@
+#ifndef libhangul_test_alloccounter_h
+#define libhangul_test_alloccounter_h
+
+#include <stdlib.h>
+
+/* 성능 측정 프로그램에서 libhangul 내부의 메모리 할당 횟수를 세기 위해서
+ * malloc 계열 함수를 가로챈다. glibc 에서만 셀 수 있고, 다른 곳에서는
+ * n_allocs 가 항상 0이다. */
+
+#ifdef __GLIBC__
+#define HAVE_ALLOC_COUNTER 1
+#else
+#define HAVE_ALLOC_COUNTER 0
+#endif /* __GLIBC__ */
+
+extern unsigned long n_allocs;
+
+#endif /* libhangul_test_alloccounter_h */
@@ -0,0 +1,40 @@
+#!/bin/sh
+# hangul -j N 의 결과가 hangul -j 1 과 같은지 확인한다.
+# 끝에 경계 키가 없는 입력과, 중간 이후에 경계가 없어서 앞의 작업이
+# 끝까지 처리하는 입력도 확인한다.
+#
+# 사용법: hangul-jobs.sh [hangul 프로그램 경로]
+
+HANGUL=${1:-${HANGUL:-hangul}}
+
+tmpdir=$(mktemp -d "${TMPDIR:-/tmp}/hangul-jobs-XXXXXX") || exit 1
+trap 'rm -rf "$tmpdir"' EXIT
+
+words=""
+i=0
+while [ $i -lt 200 ]; do
+    words="${words}dkssudgktpdy"
+    i=$((i + 1))
+done
+
+printf 'dkssudgktpdy' > "$tmpdir/input1"
+printf 'rk %s' "$words" > "$tmpdir/input2"
+printf '%s %s ' "$words" "$words" > "$tmpdir/input3"
+
+failed=0
+for keyboard in 2 2y 39 3f 3s 3y 32 ro ahn; do
+    for option in "" -s; do
+	for input in "$tmpdir"/input*; do
+	    "$HANGUL" -k $keyboard $option -j 1 "$input" > "$tmpdir/expected" || exit 1
+	    for jobs in 2 3 8; do
+		"$HANGUL" -k $keyboard $option -j $jobs "$input" > "$tmpdir/output" || exit 1
+		if ! cmp -s "$tmpdir/expected" "$tmpdir/output"; then
+		    echo "FAIL: -k $keyboard $option -j $jobs $(basename "$input")"
+		    failed=1
+		fi
+	    done
+	done
+    done
+done
+
+exit $failed
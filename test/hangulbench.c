@@ -0,0 +1,402 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "../hangul/hangul.h"
+#include "alloccounter.h"
+
+/* 키 입력 처리 성능 측정 프로그램
+ *
+ * 키 입력 코퍼스를 모든 자판과 모든 옵션 조합으로 hangul_ic_process() 에
+ * 넣어보고 키 하나에 걸린 시간, 초당 commit 수, malloc 호출 횟수,
+ * 캐시 미스 수를 출력한다. 코퍼스 파일은 키 입력을 그대로 적은
+ * 텍스트이거나 hangul_ic_dump_trace() 로 저장한 기록이다. 파일을 주지
+ * 않으면 영문 자판의 글자와 공백, backspace로 코퍼스를 만든다.
+ * 출력 형식은 탭으로 구분된 key=value 필드로 되어 있어서 스크립트로
+ * 비교하기 쉽다. checksum 은 commit 된 글자로 계산하므로 조합 결과가
+ * 바뀌었는지 확인하는데 사용한다. */
+
+#ifndef TEST_LIBHANGUL_KEYBOARD_PATH
+#define TEST_LIBHANGUL_KEYBOARD_PATH NULL
+#endif
+
+/* 옵션 조합의 각 비트, 출력할 때는 이 순서대로 한 글자씩 표시한다. */
+enum {
+    BENCH_AUTO_REORDER    = 1 << 0,
+    BENCH_DOUBLE_STROKE   = 1 << 1,
+    BENCH_NON_CHOSEONG    = 1 << 2,
+    BENCH_TRANSITION      = 1 << 3,
+    BENCH_OUTPUT_JAMO     = 1 << 4,
+    BENCH_ALL_OPTIONS     = (1 << 5) - 1
+};
+
+static const char bench_option_flags[] = "rdntj";
+
+typedef struct {
+    int* keys;
+    size_t n;
+    size_t alloc;
+} KeyList;
+
+typedef struct {
+    double elapsed;
+    unsigned long commits;
+    unsigned long commit_chars;
+    unsigned int checksum;
+} RunResult;
+
+static double
+now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#ifdef __linux__
+static int
+cache_counter_open(void)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void
+cache_counter_start(int fd)
+{
+    if (fd >= 0) {
+	ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+	ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static long long
+cache_counter_stop(int fd)
+{
+    long long count = 0;
+
+    if (fd < 0)
+	return -1;
+
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &count, sizeof(count)) != sizeof(count))
+	return -1;
+    return count;
+}
+#else
+static int cache_counter_open(void) { return -1; }
+static void cache_counter_start(int fd) { }
+static long long cache_counter_stop(int fd) { return -1; }
+#endif /* __linux__ */
+
+static void
+key_list_append(KeyList* list, int key)
+{
+    if (list->n >= list->alloc) {
+	size_t n = list->alloc == 0 ? 4096 : list->alloc * 2;
+	int* keys = realloc(list->keys, n * sizeof(keys[0]));
+	if (keys == NULL)
+	    return;
+	list->keys = keys;
+	list->alloc = n;
+    }
+
+    list->keys[list->n++] = key;
+}
+
+/* hangul_ic_dump_trace() 로 저장한 기록이면 key= 줄의 키만 사용하고,
+ * 아니면 파일의 바이트를 그대로 키로 사용한다. */
+static void
+key_list_load(KeyList* list, FILE* file)
+{
+    char buf[1024];
+    int c;
+
+    c = fgetc(file);
+    if (c == EOF)
+	return;
+    ungetc(c, file);
+
+    if (c == '#' && fgets(buf, sizeof(buf), file) != NULL &&
+	strncmp(buf, "# libhangul trace", 17) == 0) {
+	while (fgets(buf, sizeof(buf), file) != NULL) {
+	    int key;
+	    if (sscanf(buf, "key=%d", &key) == 1)
+		key_list_append(list, key);
+	}
+	return;
+    }
+
+    if (c == '#') {
+	/* 첫 줄도 키 입력이다. */
+	const char* p;
+	for (p = buf; *p != '\0'; p++)
+	    key_list_append(list, (unsigned char)*p);
+    }
+
+    while ((c = fgetc(file)) != EOF)
+	key_list_append(list, c);
+}
+
+static void
+key_list_synthesize(KeyList* list, size_t n, unsigned int seed)
+{
+    static const char keys[] =
+	"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"abcdefghijklmnopqrstuvwxyz0123456789;',./[]";
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+	unsigned int r;
+
+	seed = seed * 1103515245 + 12345;
+	r = seed >> 8;
+	if (r % 100 < 15)
+	    key_list_append(list, ' ');
+	else if (r % 100 < 18)
+	    key_list_append(list, '\b');
+	else
+	    key_list_append(list, keys[(r / 100) % (sizeof(keys) - 1)]);
+    }
+}
+
+static void
+set_options(HangulInputContext* hic, int options)
+{
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_AUTO_REORDER,
+			 options & BENCH_AUTO_REORDER);
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_COMBI_ON_DOUBLE_STROKE,
+			 options & BENCH_DOUBLE_STROKE);
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_NON_CHOSEONG_COMBI,
+			 options & BENCH_NON_CHOSEONG);
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_TRANSITION_TABLE,
+			 options & BENCH_TRANSITION);
+    hangul_ic_set_output_mode(hic, (options & BENCH_OUTPUT_JAMO) ?
+			      HANGUL_OUTPUT_JAMO : HANGUL_OUTPUT_SYLLABLE);
+}
+
+static unsigned int
+checksum_update(unsigned int hash, const ucschar* str, int len)
+{
+    int i;
+
+    /* FNV-1a */
+    for (i = 0; i < len; i++) {
+	hash ^= str[i];
+	hash *= 16777619;
+    }
+    return hash;
+}
+
+static void
+run_once(HangulInputContext* hic, const KeyList* keys, RunResult* result)
+{
+    unsigned int hash = 2166136261u;
+    unsigned long commits = 0;
+    unsigned long commit_chars = 0;
+    const ucschar* str;
+    double start;
+    size_t i;
+    int len;
+
+    hangul_ic_reset(hic);
+
+    start = now_ns();
+    for (i = 0; i < keys->n; i++) {
+	hangul_ic_process(hic, keys->keys[i]);
+	str = hangul_ic_get_commit_string_len(hic, &len);
+	if (len > 0) {
+	    commits++;
+	    commit_chars += len;
+	    hash = checksum_update(hash, str, len);
+	}
+    }
+    str = hangul_ic_flush_len(hic, &len);
+    result->elapsed = now_ns() - start;
+
+    hash = checksum_update(hash, str, len);
+    result->commits = commits;
+    result->commit_chars = commit_chars + len;
+    result->checksum = hash;
+}
+
+static void
+run(const char* keyboard, int options, const KeyList* keys, unsigned repeat,
+    int cache_fd)
+{
+    HangulInputContext* hic;
+    RunResult best = { 0, };
+    RunResult result;
+    unsigned long allocs;
+    long long misses;
+    char flags[sizeof(bench_option_flags)];
+    unsigned r;
+    int i;
+
+    if (keys->n == 0)
+	return;
+
+    allocs = n_allocs;
+    hic = hangul_ic_new(keyboard);
+    if (hic == NULL)
+	return;
+    set_options(hic, options);
+
+    cache_counter_start(cache_fd);
+    for (r = 0; r < repeat; r++) {
+	run_once(hic, keys, &result);
+	if (r == 0 || result.elapsed < best.elapsed)
+	    best = result;
+    }
+    misses = cache_counter_stop(cache_fd);
+
+    hangul_ic_delete(hic);
+    allocs = n_allocs - allocs;
+
+    for (i = 0; bench_option_flags[i] != '\0'; i++)
+	flags[i] = (options & (1 << i)) ? bench_option_flags[i] : '-';
+    flags[i] = '\0';
+
+    printf("keyboard=%s\toptions=%s\tkeys=%zu\tns_per_key=%.2f\t"
+	   "keys_per_sec=%.0f\tcommits_per_sec=%.0f\tcommit_chars=%lu",
+	   keyboard, flags, keys->n,
+	   best.elapsed / keys->n,
+	   best.elapsed > 0 ? keys->n / (best.elapsed / 1e9) : 0,
+	   best.elapsed > 0 ? best.commits / (best.elapsed / 1e9) : 0,
+	   best.commit_chars);
+    if (HAVE_ALLOC_COUNTER)
+	printf("\tallocs_per_key=%.4f", (double)allocs / (keys->n * repeat));
+    if (misses >= 0)
+	printf("\tcache_misses_per_key=%.3f", (double)misses / (keys->n * repeat));
+    printf("\tchecksum=%08x\n", best.checksum);
+}
+
+static void
+usage(const char* program_name)
+{
+    fprintf(stderr,
+	    "Usage: %s [-k KEYBOARD] [-o OPTIONS] [-n REPEAT] [-l LENGTH] [-s SEED]"
+	    " [CORPUS...]\n"
+	    "  OPTIONS is a mask of the flags %s, e.g. 0x08 for transition table only\n",
+	    program_name, bench_option_flags);
+    exit(EXIT_FAILURE);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char* keyboard = NULL;
+    int option_mask = -1;
+    unsigned repeat = 3;
+    size_t length = 200000;
+    unsigned int seed = 1;
+    KeyList keys = { NULL, 0, 0 };
+    int cache_fd;
+    unsigned i;
+    int options;
+    int c;
+
+    while ((c = getopt(argc, argv, "k:o:n:l:s:")) != -1) {
+	switch (c) {
+	case 'k':
+	    keyboard = optarg;
+	    break;
+	case 'o':
+	    option_mask = strtol(optarg, NULL, 0) & BENCH_ALL_OPTIONS;
+	    break;
+	case 'n':
+	    repeat = strtoul(optarg, NULL, 10);
+	    break;
+	case 'l':
+	    length = strtoul(optarg, NULL, 10);
+	    break;
+	case 's':
+	    seed = strtoul(optarg, NULL, 10);
+	    break;
+	default:
+	    usage(argv[0]);
+	}
+    }
+
+    if (repeat == 0)
+	repeat = 1;
+
+#if ENABLE_EXTERNAL_KEYBOARDS
+    hangul_init(TEST_LIBHANGUL_KEYBOARD_PATH);
+#endif // ENABLE_EXTERNAL_KEYBOARDS
+
+    for (; optind < argc; optind++) {
+	FILE* file;
+
+	if (strcmp(argv[optind], "-") == 0)
+	    file = stdin;
+	else
+	    file = fopen(argv[optind], "r");
+	if (file == NULL) {
+	    fprintf(stderr, "%s: cannot open corpus: %s\n", argv[0],
+		    argv[optind]);
+	    return EXIT_FAILURE;
+	}
+	key_list_load(&keys, file);
+	if (file != stdin)
+	    fclose(file);
+    }
+
+    if (keys.n == 0) {
+	key_list_synthesize(&keys, length, seed);
+	printf("mode=corpus\tsource=synthesized\tseed=%u\tkeys=%zu\n",
+	       seed, keys.n);
+    } else {
+	printf("mode=corpus\tsource=files\tkeys=%zu\n", keys.n);
+    }
+
+    cache_fd = cache_counter_open();
+
+    for (i = 0; i < hangul_keyboard_list_get_count(); i++) {
+	const char* id = hangul_keyboard_list_get_keyboard_id(i);
+
+	if (keyboard != NULL && strcmp(keyboard, id) != 0)
+	    continue;
+
+	for (options = 0; options <= BENCH_ALL_OPTIONS; options++) {
+	    if (option_mask >= 0 && options != option_mask)
+		continue;
+	    run(id, options, &keys, repeat, cache_fd);
+	}
+    }
+
+#ifdef __linux__
+    if (cache_fd >= 0)
+	close(cache_fd);
+#endif
+
+    free(keys.keys);
+
+#if ENABLE_EXTERNAL_KEYBOARDS
+    hangul_fini();
+#endif // ENABLE_EXTERNAL_KEYBOARDS
+
+    return EXIT_SUCCESS;
+}
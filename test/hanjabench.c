@@ -0,0 +1,246 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+#include "../hangul/hangul.h"
+#include "alloccounter.h"
+
+/* 한자 사전 검색 성능 측정 프로그램
+ *
+ * 질의 목록의 각 줄을 exact, prefix, suffix 검색으로 차례로 찾아보고
+ * 검색 한번에 걸린 시간의 분포와 malloc 호출 횟수, 그리고
+ * hanja_table_get_stats() 로 구한 검색당 레코드 수를 출력한다.
+ * 질의 파일을 주지 않으면 사전의 키를 일정한 간격으로 골라서 사용한다.
+ * 출력 형식은 탭으로 구분된 key=value 필드로 되어 있어서 스크립트로
+ * 비교하기 쉽다. */
+
+#ifndef TEST_HANJA_TXT
+#define TEST_HANJA_TXT NULL
+#endif
+
+typedef HanjaList* (*HanjaMatchFunc)(const HanjaTable*, const char*);
+
+typedef struct {
+    char** lines;
+    size_t n;
+    size_t alloc;
+} QueryList;
+
+static double
+now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int
+compare_double(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+
+    if (x < y)
+	return -1;
+    else if (x > y)
+	return 1;
+    return 0;
+}
+
+static void
+query_list_append(QueryList* list, const char* query)
+{
+    if (list->n >= list->alloc) {
+	size_t n = list->alloc == 0 ? 1024 : list->alloc * 2;
+	char** lines = realloc(list->lines, n * sizeof(lines[0]));
+	if (lines == NULL)
+	    return;
+	list->lines = lines;
+	list->alloc = n;
+    }
+
+    list->lines[list->n++] = strdup(query);
+}
+
+static void
+query_list_load(QueryList* list, FILE* file, int sample_keys, unsigned step)
+{
+    char buf[512];
+    unsigned i = 0;
+
+    while (fgets(buf, sizeof(buf), file) != NULL) {
+	char* p;
+
+	if (buf[0] == '#' || buf[0] == '\r' || buf[0] == '\n')
+	    continue;
+
+	if (sample_keys) {
+	    /* 사전 파일이면 첫번째 필드만 키로 사용한다. */
+	    p = strchr(buf, ':');
+	    if (p == NULL)
+		continue;
+	    *p = '\0';
+
+	    if (i++ % step != 0)
+		continue;
+	    if (list->n > 0 && strcmp(list->lines[list->n - 1], buf) == 0)
+		continue;
+	} else {
+	    p = strpbrk(buf, "\r\n");
+	    if (p != NULL)
+		*p = '\0';
+	}
+
+	query_list_append(list, buf);
+    }
+}
+
+static void
+run(const char* mode, HanjaMatchFunc match, HanjaTable* table,
+    const QueryList* queries, unsigned repeat)
+{
+    size_t nsamples = queries->n * repeat;
+    double* samples;
+    double total = 0;
+    unsigned long nresults = 0;
+    unsigned long allocs;
+    size_t i, r;
+
+    if (nsamples == 0)
+	return;
+
+    samples = malloc(nsamples * sizeof(samples[0]));
+    if (samples == NULL)
+	return;
+
+    hanja_table_reset_stats(table);
+    allocs = n_allocs;
+    for (r = 0; r < repeat; r++) {
+	for (i = 0; i < queries->n; i++) {
+	    double start = now_ns();
+	    HanjaList* list = match(table, queries->lines[i]);
+	    nresults += hanja_list_get_size(list);
+	    hanja_list_delete(list);
+	    double elapsed = now_ns() - start;
+
+	    samples[r * queries->n + i] = elapsed;
+	    total += elapsed;
+	}
+    }
+    allocs = n_allocs - allocs;
+
+    qsort(samples, nsamples, sizeof(samples[0]), compare_double);
+
+    printf("mode=%s\tqueries=%zu\tresults=%lu\t"
+	   "p50_ns=%.0f\tp99_ns=%.0f\tmax_ns=%.0f\tqps=%.0f",
+	   mode, nsamples, nresults,
+	   samples[nsamples / 2],
+	   samples[(size_t)(nsamples * 0.99)],
+	   samples[nsamples - 1],
+	   total > 0 ? nsamples / (total / 1e9) : 0);
+    if (HAVE_ALLOC_COUNTER)
+	printf("\tallocs_per_query=%.2f", (double)allocs / nsamples);
+    printf("\trecords_per_query=%.2f\tmax_records=%lu\tbytes_per_query=%.0f\n",
+	   (double)hanja_table_get_stats(table, HANJA_TABLE_STATS_RECORDS_SCANNED) / nsamples,
+	   hanja_table_get_stats(table, HANJA_TABLE_STATS_MAX_RECORDS_SCANNED),
+	   (double)hanja_table_get_stats(table, HANJA_TABLE_STATS_BYTES_READ) / nsamples);
+
+    free(samples);
+}
+
+static void
+usage(const char* program_name)
+{
+    fprintf(stderr,
+	    "Usage: %s [-d DICTIONARY] [-n REPEAT] [-s STEP] [QUERYFILE]\n",
+	    program_name);
+    exit(EXIT_FAILURE);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char* hanja_table_file = TEST_HANJA_TXT;
+    const char* query_file = NULL;
+    unsigned repeat = 1;
+    unsigned step = 100;
+    QueryList queries = { NULL, 0, 0 };
+    HanjaTable* table;
+    FILE* file;
+    double start;
+    size_t i;
+    int c;
+
+    while ((c = getopt(argc, argv, "d:n:s:")) != -1) {
+	switch (c) {
+	case 'd':
+	    hanja_table_file = optarg;
+	    break;
+	case 'n':
+	    repeat = strtoul(optarg, NULL, 10);
+	    break;
+	case 's':
+	    step = strtoul(optarg, NULL, 10);
+	    break;
+	default:
+	    usage(argv[0]);
+	}
+    }
+
+    if (optind < argc)
+	query_file = argv[optind];
+
+    if (repeat == 0)
+	repeat = 1;
+    if (step == 0)
+	step = 1;
+
+    start = now_ns();
+    table = hanja_table_load(hanja_table_file);
+    if (table == NULL) {
+	fprintf(stderr, "%s: cannot load hanja table: %s\n", argv[0],
+		hanja_table_file != NULL ? hanja_table_file : "(default)");
+	return EXIT_FAILURE;
+    }
+    printf("mode=load\tload_ms=%.3f\n", (now_ns() - start) / 1e6);
+
+    if (query_file != NULL) {
+	if (strcmp(query_file, "-") == 0)
+	    file = stdin;
+	else
+	    file = fopen(query_file, "r");
+	if (file == NULL) {
+	    fprintf(stderr, "%s: cannot open query file: %s\n", argv[0],
+		    query_file);
+	    hanja_table_delete(table);
+	    return EXIT_FAILURE;
+	}
+	query_list_load(&queries, file, 0, 1);
+	if (file != stdin)
+	    fclose(file);
+    } else if (hanja_table_file != NULL) {
+	file = fopen(hanja_table_file, "r");
+	if (file != NULL) {
+	    query_list_load(&queries, file, 1, step);
+	    fclose(file);
+	}
+    }
+
+    run("exact",  hanja_table_match_exact,  table, &queries, repeat);
+    run("prefix", hanja_table_match_prefix, table, &queries, repeat);
+    run("suffix", hanja_table_match_suffix, table, &queries, repeat);
+
+    hanja_table_delete(table);
+
+    for (i = 0; i < queries.n; i++)
+	free(queries.lines[i]);
+    free(queries.lines);
+
+    return EXIT_SUCCESS;
+}
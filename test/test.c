@@ -1,12 +1,16 @@
 #include <stdarg.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <wchar.h>
 #include <check.h>
+#if ENABLE_EXTERNAL_KEYBOARDS
+#include <dirent.h>
+#include <unistd.h>
+#endif /* ENABLE_EXTERNAL_KEYBOARDS */
 
 #include "../hangul/hangul.h"
-
-#define countof(x)  ((sizeof(x)) / (sizeof(x[0])))
+#include "../hangul/hangulinternals.h"
 
 static HangulInputContext* global_ic = NULL;
 
@@ -416,6 +420,802 @@ START_TEST(test_hangul_ic_non_choseong_combi)
 END_TEST
 }
 
+typedef struct {
+    ucschar str[128];
+    int len;
+    int ncalls;
+} CommitSink;
+
+static void
+on_commit(HangulInputContext* ic, const ucschar* str, int len, void* data)
+{
+    CommitSink* sink = data;
+    int i;
+
+    for (i = 0; i < len && sink->len + 1 < countof(sink->str); i++)
+	sink->str[sink->len++] = str[i];
+    sink->str[sink->len] = 0;
+    sink->ncalls++;
+}
+
+START_TEST(test_hangul_ic_commit_callback)
+{
+    HangulInputContext* ic;
+    CommitSink sink = { { 0 }, 0, 0 };
+    const char* keys = "gksrmf dlqfur";
+    const char* p;
+
+    ic = hangul_ic_new("2");
+    hangul_ic_connect_callback(ic, "commit", on_commit, &sink);
+
+    for (p = keys; *p != '\0'; p++) {
+	hangul_ic_process(ic, *p);
+	ck_assert(hangul_ic_get_commit_string(ic)[0] == 0);
+    }
+
+    /* 공백은 처리하지 않으므로 조합중인 글자만 commit 된다 */
+    ck_assert(wcscmp((const wchar_t*)sink.str, L"한글입") == 0);
+    ck_assert(sink.ncalls == 3);
+    ck_assert(wcscmp((const wchar_t*)hangul_ic_get_preedit_string(ic), L"력") == 0);
+
+    /* flush는 콜백을 부르지 않는다 */
+    ck_assert(wcscmp((const wchar_t*)hangul_ic_flush(ic), L"력") == 0);
+    ck_assert(sink.ncalls == 3);
+
+    /* 연결을 끊으면 예전처럼 commit string에 저장한다 */
+    hangul_ic_connect_callback(ic, "commit", NULL, NULL);
+    hangul_ic_process(ic, 'r');
+    hangul_ic_process(ic, 'k');
+    hangul_ic_process(ic, 'r');
+    hangul_ic_process(ic, 'k');
+    ck_assert(wcscmp((const wchar_t*)hangul_ic_get_commit_string(ic), L"가") == 0);
+    ck_assert(sink.ncalls == 3);
+
+    hangul_ic_delete(ic);
+}
+END_TEST
+
+START_TEST(test_hangul_ic_string_length)
+{
+    HangulInputContext* ic;
+    const ucschar* str;
+    int len;
+
+    ic = get_ic("2");
+
+    str = hangul_ic_get_preedit_string_len(ic, &len);
+    ck_assert(len == 0);
+    ck_assert(str[0] == 0);
+
+    hangul_ic_process(ic, 'g');
+    hangul_ic_process(ic, 'k');
+    hangul_ic_process(ic, 's');
+    str = hangul_ic_get_preedit_string_len(ic, &len);
+    ck_assert(len == 1);
+    ck_assert(str[0] == 0xd55c && str[1] == 0);
+
+    hangul_ic_process(ic, 'r');
+    str = hangul_ic_get_commit_string_len(ic, &len);
+    ck_assert(len == 1);
+    ck_assert(str[0] == 0xd55c && str[1] == 0);
+    str = hangul_ic_get_preedit_string_len(ic, &len);
+    ck_assert(len == 1);
+
+    /* 자모 출력 모드에서는 한 음절이 여러 자모로 저장된다 */
+    hangul_ic_reset(ic);
+    hangul_ic_set_output_mode(ic, HANGUL_OUTPUT_JAMO);
+    hangul_ic_process(ic, 'r');
+    hangul_ic_process(ic, 'k');
+    str = hangul_ic_get_preedit_string_len(ic, &len);
+    ck_assert(len == 2);
+    str = hangul_ic_flush_len(ic, &len);
+    ck_assert(len == 2);
+    ck_assert(str[2] == 0);
+
+    str = hangul_ic_flush_len(ic, &len);
+    ck_assert(len == 0);
+    hangul_ic_get_preedit_string_len(ic, &len);
+    ck_assert(len == 0);
+    hangul_ic_get_commit_string_len(ic, &len);
+    ck_assert(len == 0);
+
+    hangul_ic_set_output_mode(ic, HANGUL_OUTPUT_SYLLABLE);
+}
+END_TEST
+
+START_TEST(test_hangul_ic_transition_table)
+{
+    unsigned i, n;
+    int option;
+
+    /* 같은 키 입력에 대해 표를 사용한 결과와 조합 함수의 결과가
+     * 같아야 한다. */
+    n = hangul_keyboard_list_get_count();
+    for (i = 0; i < n; i++) {
+	const char* id = hangul_keyboard_list_get_keyboard_id(i);
+
+	for (option = 0; option < 8; option++) {
+	    HangulInputContext* ref = hangul_ic_new(id);
+	    HangulInputContext* ic = hangul_ic_new(id);
+	    unsigned seed = i * 8 + option + 1;
+	    int k;
+
+	    hangul_ic_set_option(ref, HANGUL_IC_OPTION_AUTO_REORDER, option & 1);
+	    hangul_ic_set_option(ic, HANGUL_IC_OPTION_AUTO_REORDER, option & 1);
+	    hangul_ic_set_option(ref, HANGUL_IC_OPTION_COMBI_ON_DOUBLE_STROKE, option & 2);
+	    hangul_ic_set_option(ic, HANGUL_IC_OPTION_COMBI_ON_DOUBLE_STROKE, option & 2);
+	    hangul_ic_set_option(ref, HANGUL_IC_OPTION_NON_CHOSEONG_COMBI, option & 4);
+	    hangul_ic_set_option(ic, HANGUL_IC_OPTION_NON_CHOSEONG_COMBI, option & 4);
+	    hangul_ic_set_option(ic, HANGUL_IC_OPTION_TRANSITION_TABLE, true);
+
+	    for (k = 0; k < 20000; k++) {
+		int key;
+		bool r1, r2;
+
+		seed = seed * 1103515245 + 12345;
+		key = (seed >> 16) % 100;
+		if (key < 4)
+		    key = '\b';
+		else if (key < 8)
+		    key = ' ';
+		else
+		    key = 0x21 + (seed >> 8) % 94;
+
+		r1 = hangul_ic_process(ref, key);
+		r2 = hangul_ic_process(ic, key);
+		ck_assert(r1 == r2);
+		ck_assert(wcscmp((const wchar_t*)hangul_ic_get_preedit_string(ref),
+				 (const wchar_t*)hangul_ic_get_preedit_string(ic)) == 0);
+		ck_assert(wcscmp((const wchar_t*)hangul_ic_get_commit_string(ref),
+				 (const wchar_t*)hangul_ic_get_commit_string(ic)) == 0);
+		if (r1 != r2)
+		    break;
+	    }
+
+	    ck_assert(wcscmp((const wchar_t*)hangul_ic_flush(ref),
+			     (const wchar_t*)hangul_ic_flush(ic)) == 0);
+
+	    hangul_ic_delete(ref);
+	    hangul_ic_delete(ic);
+	}
+    }
+}
+END_TEST
+
+/* 만든 자판을 고치는 방법은 deprecated 된 hangul_keyboard_set_value() 밖에
+ * 없다. */
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+static void
+set_keyboard_value(HangulKeyboard* keyboard, int key, ucschar value)
+{
+    hangul_keyboard_set_value(keyboard, key, value);
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+/* 표를 만든 뒤에 자판을 바꾸거나 새로 만들어도 이전 자판의 표를 사용하지
+ * 않아야 한다. */
+START_TEST(test_hangul_ic_transition_table_keyboard_change)
+{
+    HangulInputContextPool* pool;
+    HangulInputContext* ic[2];
+    HangulKeyboard* keyboard;
+    int i, k;
+
+    pool = hangul_ic_pool_new();
+    ic[0] = hangul_ic_new("2");
+    ic[1] = hangul_ic_new_from_pool(pool, "2");
+
+    for (i = 0; i < 2; i++) {
+	hangul_ic_set_option(ic[i], HANGUL_IC_OPTION_TRANSITION_TABLE, true);
+
+	keyboard = hangul_keyboard_new();
+	set_keyboard_value(keyboard, 'a', 0x1100);
+	set_keyboard_value(keyboard, 'k', 0x1161);
+	hangul_ic_set_keyboard(ic[i], keyboard);
+	hangul_ic_process(ic[i], 'a');
+	hangul_ic_process(ic[i], 'k');
+	ck_assert(hangul_ic_get_preedit_string(ic[i])[0] == 0xac00);
+	hangul_ic_reset(ic[i]);
+
+	set_keyboard_value(keyboard, 'a', 0x1103);
+	hangul_ic_process(ic[i], 'a');
+	hangul_ic_process(ic[i], 'k');
+	ck_assert(hangul_ic_get_preedit_string(ic[i])[0] == 0xb2e4);
+	hangul_ic_reset(ic[i]);
+
+	for (k = 0; k < 4; k++) {
+	    hangul_ic_select_keyboard(ic[i], "2");
+	    hangul_ic_process(ic[i], 'r');
+	    hangul_ic_reset(ic[i]);
+	    hangul_keyboard_delete(keyboard);
+
+	    keyboard = hangul_keyboard_new();
+	    set_keyboard_value(keyboard, 'a', 0x1102 + k);
+	    set_keyboard_value(keyboard, 'k', 0x1161);
+	    hangul_ic_set_keyboard(ic[i], keyboard);
+	    hangul_ic_process(ic[i], 'a');
+	    hangul_ic_process(ic[i], 'k');
+	    ck_assert(hangul_ic_get_preedit_string(ic[i])[0] ==
+		      hangul_jamo_to_syllable(0x1102 + k, 0x1161, 0));
+	    hangul_ic_reset(ic[i]);
+	}
+
+	hangul_ic_delete(ic[i]);
+	hangul_keyboard_delete(keyboard);
+    }
+
+    hangul_ic_pool_delete(pool);
+}
+END_TEST
+
+START_TEST(test_hangul_ic_pool)
+{
+    HangulInputContextPool* pool;
+    HangulInputContext* ref[300];
+    HangulInputContext* ic[300];
+    const char* keyboards[] = { "2", "2y", "32", "39", "3f", "3s", "3y", "ro" };
+    unsigned seed = 1;
+    int i, k;
+
+    /* pool에서 만든 입력 상태는 결과 스트링 버퍼를 공유하지만 여러
+     * 입력 상태를 번갈아 사용해도 각각 따로 만든 것과 결과가 같아야 한다.
+     * slab 하나보다 많은 수를 만들어 본다. 자판과 옵션의 조합은 pool 이
+     * 가지고 있는 상태 전이표의 수보다 많게 한다. */
+    pool = hangul_ic_pool_new();
+    ck_assert(pool != NULL);
+
+    for (i = 0; i < countof(ic); i++) {
+	const char* id = keyboards[i % countof(keyboards)];
+	ref[i] = hangul_ic_new(id);
+	ic[i] = hangul_ic_new_from_pool(pool, id);
+	ck_assert(ic[i] != NULL);
+	hangul_ic_set_option(ref[i], HANGUL_IC_OPTION_AUTO_REORDER, i % 3 == 0);
+	hangul_ic_set_option(ic[i], HANGUL_IC_OPTION_AUTO_REORDER, i % 3 == 0);
+	hangul_ic_set_option(ic[i], HANGUL_IC_OPTION_TRANSITION_TABLE, i % 2);
+    }
+
+    for (k = 0; k < 100000; k++) {
+	int key;
+	bool r1, r2;
+
+	seed = seed * 1103515245 + 12345;
+	i = (seed >> 8) % countof(ic);
+	seed = seed * 1103515245 + 12345;
+	key = (seed >> 16) % 100;
+	if (key < 4)
+	    key = '\b';
+	else if (key < 8)
+	    key = ' ';
+	else
+	    key = 'a' + (seed >> 8) % 26;
+
+	r1 = hangul_ic_process(ref[i], key);
+	r2 = hangul_ic_process(ic[i], key);
+	ck_assert(r1 == r2);
+	ck_assert(wcscmp((const wchar_t*)hangul_ic_get_commit_string(ref[i]),
+			 (const wchar_t*)hangul_ic_get_commit_string(ic[i])) == 0);
+
+	/* 다른 입력 상태를 사용한 후에도 preedit 스트링은 그대로다 */
+	i = (seed >> 4) % countof(ic);
+	ck_assert(wcscmp((const wchar_t*)hangul_ic_get_preedit_string(ref[i]),
+			 (const wchar_t*)hangul_ic_get_preedit_string(ic[i])) == 0);
+
+	/* 삭제한 입력 상태는 pool에서 다시 사용한다 */
+	if (k % 1000 == 999) {
+	    const char* id = keyboards[i % countof(keyboards)];
+	    hangul_ic_delete(ref[i]);
+	    hangul_ic_delete(ic[i]);
+	    ref[i] = hangul_ic_new(id);
+	    ic[i] = hangul_ic_new_from_pool(pool, id);
+	    hangul_ic_set_option(ref[i], HANGUL_IC_OPTION_AUTO_REORDER, i % 3 == 0);
+	    hangul_ic_set_option(ic[i], HANGUL_IC_OPTION_AUTO_REORDER, i % 3 == 0);
+	    hangul_ic_set_option(ic[i], HANGUL_IC_OPTION_TRANSITION_TABLE, i % 2);
+	}
+    }
+
+    for (i = 0; i < countof(ic); i++) {
+	ck_assert(wcscmp((const wchar_t*)hangul_ic_flush(ref[i]),
+			 (const wchar_t*)hangul_ic_flush(ic[i])) == 0);
+	hangul_ic_delete(ref[i]);
+	hangul_ic_delete(ic[i]);
+    }
+
+    hangul_ic_pool_delete(pool);
+}
+END_TEST
+
+START_TEST(test_hangul_ic_save_state)
+{
+    HangulInputContext* ic;
+    unsigned char state[HANGUL_IC_STATE_SIZE_MAX];
+    unsigned char small[4];
+    unsigned i, n;
+    int len;
+
+    /* 저장했다가 다른 입력 상태에 복원하면 이후의 조합 결과가 같아야 한다. */
+    n = hangul_keyboard_list_get_count();
+    for (i = 0; i < n; i++) {
+	const char* id = hangul_keyboard_list_get_keyboard_id(i);
+	unsigned seed = i + 1;
+	int k;
+
+	ic = hangul_ic_new(id);
+	hangul_ic_set_option(ic, HANGUL_IC_OPTION_AUTO_REORDER, i % 2);
+	hangul_ic_set_option(ic, HANGUL_IC_OPTION_TRANSITION_TABLE, i % 3 == 0);
+
+	for (k = 0; k < 2000; k++) {
+	    HangulInputContext* restored;
+	    bool r1, r2;
+	    int key;
+
+	    seed = seed * 1103515245 + 12345;
+	    key = 'a' + (seed >> 16) % 26;
+	    hangul_ic_process(ic, key);
+
+	    len = hangul_ic_save_state(ic, state, sizeof(state));
+	    ck_assert(len > 0 && len <= sizeof(state));
+
+	    restored = hangul_ic_new("2");
+	    ck_assert(hangul_ic_restore_state(restored, state, len));
+	    ck_assert(wcscmp((const wchar_t*)hangul_ic_get_preedit_string(ic),
+			     (const wchar_t*)hangul_ic_get_preedit_string(restored)) == 0);
+	    ck_assert(hangul_ic_get_commit_string(restored)[0] == 0);
+	    ck_assert(hangul_ic_get_option(restored, HANGUL_IC_OPTION_AUTO_REORDER) == i % 2);
+
+	    seed = seed * 1103515245 + 12345;
+	    key = (seed >> 16) % 10 == 0 ? '\b' : 'a' + (seed >> 8) % 26;
+	    r1 = hangul_ic_process(ic, key);
+	    r2 = hangul_ic_process(restored, key);
+	    ck_assert(r1 == r2);
+	    ck_assert(wcscmp((const wchar_t*)hangul_ic_get_commit_string(ic),
+			     (const wchar_t*)hangul_ic_get_commit_string(restored)) == 0);
+	    ck_assert(wcscmp((const wchar_t*)hangul_ic_flush(ic),
+			     (const wchar_t*)hangul_ic_flush(restored)) == 0);
+	    hangul_ic_delete(restored);
+	}
+
+	hangul_ic_delete(ic);
+    }
+
+    ic = hangul_ic_new("2");
+    hangul_ic_process(ic, 'g');
+    hangul_ic_process(ic, 'k');
+    hangul_ic_process(ic, 's');
+
+    /* 버퍼가 작으면 필요한 크기만 알려준다 */
+    len = hangul_ic_save_state(ic, small, sizeof(small));
+    ck_assert(len > sizeof(small));
+    ck_assert(hangul_ic_save_state(ic, state, sizeof(state)) == len);
+
+    /* 잘못된 형식은 복원하지 않고 상태도 바꾸지 않는다 */
+    ck_assert(!hangul_ic_restore_state(ic, state, len - 1));
+    state[3]++;
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+    state[3]--;
+    state[7] = 'x';
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+    ck_assert(hangul_ic_get_preedit_string(ic)[0] == 0xd55c);
+
+    /* 잘린 상태는 어디에서 잘려도 복원하지 않는다 */
+    len = hangul_ic_save_state(ic, state, sizeof(state));
+    for (i = 0; i < len; i++)
+	ck_assert(!hangul_ic_restore_state(ic, state, i));
+
+    hangul_ic_delete(ic);
+}
+END_TEST
+
+/* hangul_ic_save_state() 의 형식으로 "2" 자판의 상태를 만든다. */
+static int
+make_state(unsigned char* buf, ucschar cho, ucschar jung, ucschar jong,
+	   const ucschar* stack, int n)
+{
+    ucschar values[3] = { cho, jung, jong };
+    unsigned char* p = buf;
+    int i;
+
+    *p++ = 'H';
+    *p++ = 'I';
+    *p++ = 'C';
+    *p++ = 1;
+    *p++ = 0;
+    *p++ = 0;
+    *p++ = 1;
+    *p++ = '2';
+    for (i = 0; i < 3 + n; i++) {
+	ucschar c = i < 3 ? values[i] : stack[i - 3];
+	while (c >= 0x80) {
+	    *p++ = (c & 0x7f) | 0x80;
+	    c >>= 7;
+	}
+	*p++ = c;
+	if (i == 2)
+	    *p++ = n;
+    }
+
+    return p - buf;
+}
+
+START_TEST(test_hangul_ic_restore_malformed_state)
+{
+    HangulInputContext* ic;
+    unsigned char state[HANGUL_IC_STATE_SIZE_MAX];
+    ucschar stack[16];
+    int len;
+    int i;
+
+    ic = hangul_ic_new("2");
+
+    for (i = 0; i < 16; i++)
+	stack[i] = 0x1100;
+
+    /* stack 이 가득 차 있으면 더 쌓을 곳이 없다 */
+    len = make_state(state, 0x1100, 0, 0, stack, 12);
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+    len = make_state(state, 0x1100, 0, 0, stack, 13);
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+
+    /* 자모가 아닌 글자나 종류가 맞지 않는 값은 받지 않는다 */
+    stack[1] = 'a';
+    len = make_state(state, 0x1100, 0, 0, stack, 2);
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+    stack[1] = 0;
+    len = make_state(state, 0x1100, 0, 0, stack, 2);
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+    stack[1] = 0x1161;
+    len = make_state(state, 0x1161, 0, 0, stack, 2);
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+    len = make_state(state, 0x1100, 0x1162, 0, stack, 2);
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+    len = make_state(state, 0x1100, 0, 0x11a8, stack, 2);
+    ck_assert(!hangul_ic_restore_state(ic, state, len));
+    len = make_state(state, 0x1100, 0x1161, 0, stack, 2);
+    ck_assert(hangul_ic_restore_state(ic, state, len));
+    ck_assert(hangul_ic_get_preedit_string(ic)[0] == 0xac00);
+    hangul_ic_reset(ic);
+
+    /* 받을 수 있는 가장 깊은 stack 에서도 계속 입력할 수 있어야 한다 */
+    stack[1] = 0x1100;
+    len = make_state(state, 0x1100, 0, 0, stack, 11);
+    ck_assert(hangul_ic_restore_state(ic, state, len));
+    hangul_ic_set_option(ic, HANGUL_IC_OPTION_COMBI_ON_DOUBLE_STROKE, true);
+    for (i = 0; i < 8; i++)
+	hangul_ic_process(ic, 'r');
+    hangul_ic_process(ic, 'k');
+    ck_assert(hangul_ic_get_preedit_string(ic)[0] != 0);
+
+    hangul_ic_delete(ic);
+}
+END_TEST
+
+START_TEST(test_hangul_ic_process_batch)
+{
+    HangulInputContextPool* pool;
+    HangulInputContext* ref[64];
+    HangulInputContext* ic[64];
+    HangulInputContext* hics[256];
+    int keys[256];
+    bool results[256];
+    int offsets[257];
+    ucschar out[256 * 64];
+    const char* keyboards[] = { "2", "3f", "ro", "2y" };
+    unsigned seed = 1;
+    int i, k, round;
+
+    /* 여러 입력 상태의 키를 섞어서 한번에 처리한 결과가 하나씩 처리한
+     * 결과와 같아야 한다. */
+    pool = hangul_ic_pool_new();
+    for (i = 0; i < countof(ic); i++) {
+	const char* id = keyboards[i % countof(keyboards)];
+	ref[i] = hangul_ic_new(id);
+	if (i % 3 == 0)
+	    ic[i] = hangul_ic_new(id);
+	else
+	    ic[i] = hangul_ic_new_from_pool(pool, id);
+	hangul_ic_set_option(ic[i], HANGUL_IC_OPTION_TRANSITION_TABLE, i % 4 != 0);
+    }
+
+    for (round = 0; round < 200; round++) {
+	int n;
+
+	for (k = 0; k < countof(keys); k++) {
+	    seed = seed * 1103515245 + 12345;
+	    hics[k] = ic[(seed >> 8) % countof(ic)];
+	    seed = seed * 1103515245 + 12345;
+	    keys[k] = (seed >> 16) % 20 == 0 ? '\b' : 'a' + (seed >> 8) % 26;
+	}
+
+	n = hangul_ic_process_batch(hics, keys, countof(keys), results,
+				    out, countof(out), offsets);
+	ck_assert(n == countof(keys));
+
+	for (k = 0; k < n; k++) {
+	    const ucschar* commit;
+	    int len;
+
+	    for (i = 0; hics[k] != ic[i]; i++)
+		continue;
+
+	    ck_assert(hangul_ic_process(ref[i], keys[k]) == results[k]);
+	    commit = hangul_ic_get_commit_string_len(ref[i], &len);
+	    ck_assert(offsets[k + 1] - offsets[k] == len);
+	    ck_assert(memcmp(out + offsets[k], commit, len * sizeof(ucschar)) == 0);
+	}
+
+	for (i = 0; i < countof(ic); i++) {
+	    ck_assert(wcscmp((const wchar_t*)hangul_ic_get_preedit_string(ref[i]),
+			     (const wchar_t*)hangul_ic_get_preedit_string(ic[i])) == 0);
+	}
+    }
+
+    /* 출력 버퍼가 부족하면 처리할 수 있는 만큼만 처리한다 */
+    ck_assert(hangul_ic_process_batch(hics, keys, countof(keys), NULL,
+				      out, 63, offsets) == 0);
+    ck_assert(offsets[0] == 0);
+    k = hangul_ic_process_batch(hics, keys, countof(keys), NULL,
+				out, 64 * 3, offsets);
+    ck_assert(k >= 3 && k < countof(keys));
+    ck_assert(offsets[k] <= 64 * 3);
+
+    /* NULL 입력 상태의 키는 사용하지 않고 결과도 없다 */
+    hics[1] = NULL;
+    results[1] = true;
+    ck_assert(hangul_ic_process_batch(hics, keys, 3, results,
+				      out, countof(out), offsets) == 3);
+    ck_assert(!results[1]);
+    ck_assert(offsets[2] == offsets[1]);
+
+    for (i = 0; i < countof(ic); i++) {
+	hangul_ic_delete(ref[i]);
+	hangul_ic_delete(ic[i]);
+    }
+    hangul_ic_pool_delete(pool);
+}
+END_TEST
+
+START_TEST(test_hangul_ic_process_ex)
+{
+    HangulInputContext* ic;
+    HangulInputContext* ref;
+    HangulICResult result;
+    ucschar prev[64] = { 0 };
+    unsigned seed = 7;
+    int i;
+
+    /* hangul_ic_process_ex() 의 결과는 hangul_ic_process() 후에
+     * 각 함수로 구한 값과 같아야 한다. */
+    ic = hangul_ic_new("3f");
+    ref = hangul_ic_new("3f");
+    for (i = 0; i < 10000; i++) {
+	const ucschar* commit;
+	const ucschar* preedit;
+	int commit_len;
+	int preedit_len;
+	int key;
+	bool res;
+
+	/* 자모 단위 출력에서는 preedit 가 여러 글자가 된다 */
+	if (i == 5000) {
+	    hangul_ic_set_output_mode(ic, HANGUL_OUTPUT_JAMO);
+	    hangul_ic_set_output_mode(ref, HANGUL_OUTPUT_JAMO);
+	    hangul_ic_reset(ic);
+	    hangul_ic_reset(ref);
+	    prev[0] = 0;
+	}
+
+	seed = seed * 1103515245 + 12345;
+	key = (seed >> 16) % 10 == 0 ? '\b' : '!' + (seed >> 8) % 94;
+
+	res = hangul_ic_process_ex(ic, key, &result);
+	ck_assert(hangul_ic_process(ref, key) == res);
+	commit = hangul_ic_get_commit_string_len(ref, &commit_len);
+	preedit = hangul_ic_get_preedit_string_len(ref, &preedit_len);
+
+	ck_assert(!(result.flags & HANGUL_IC_RESULT_CONSUMED) == !res);
+	ck_assert(!(result.flags & HANGUL_IC_RESULT_COMMIT_CHANGED) == (commit_len == 0));
+	ck_assert(!(result.flags & HANGUL_IC_RESULT_EMPTY) == !hangul_ic_is_empty(ref));
+	ck_assert(!(result.flags & HANGUL_IC_RESULT_PREEDIT_CHANGED) ==
+		  (wcscmp((const wchar_t*)prev, (const wchar_t*)preedit) == 0));
+	ck_assert(result.commit_len == commit_len);
+	ck_assert(result.preedit_len == preedit_len);
+	ck_assert(memcmp(result.commit, commit, (commit_len + 1) * sizeof(ucschar)) == 0);
+	ck_assert(memcmp(result.preedit, preedit, (preedit_len + 1) * sizeof(ucschar)) == 0);
+
+	/* 이전 preedit 에 바뀐 부분을 적용하면 새 preedit 가 된다 */
+	ck_assert(result.preedit_prefix_len + result.preedit_removed ==
+		  wcslen((const wchar_t*)prev));
+	ck_assert(result.preedit_prefix_len + result.preedit_inserted_len == preedit_len);
+	ck_assert(memcmp(prev, preedit, result.preedit_prefix_len * sizeof(ucschar)) == 0);
+	ck_assert(result.preedit_inserted == result.preedit + result.preedit_prefix_len);
+	ck_assert(result.preedit_prefix_len == preedit_len ||
+		  result.preedit_removed == 0 ||
+		  prev[result.preedit_prefix_len] != preedit[result.preedit_prefix_len]);
+
+	memcpy(prev, preedit, (preedit_len + 1) * sizeof(ucschar));
+    }
+
+    ck_assert(hangul_ic_process_ex(ic, 'k', NULL));
+    ck_assert(!hangul_ic_process_ex(NULL, 'k', &result));
+    ck_assert(result.flags == 0 && result.commit == NULL);
+
+    hangul_ic_delete(ic);
+    hangul_ic_delete(ref);
+}
+END_TEST
+
+START_TEST(test_hangul_ic_trace)
+{
+    HangulInputContext* ic;
+    HangulInputContext* replay;
+    unsigned char state[HANGUL_IC_STATE_SIZE_MAX];
+    static char dump[64 * 1024];
+    static char dump2[64 * 1024];
+    unsigned seed = 3;
+    char* line;
+    int nevents = 0;
+    int len;
+    int i;
+
+    ic = hangul_ic_new("2");
+    ck_assert(hangul_ic_dump_trace(ic, dump, sizeof(dump)) == 0);
+    ck_assert(dump[0] == '\0');
+
+    hangul_ic_set_option(ic, HANGUL_IC_OPTION_TRACE, true);
+    ck_assert(hangul_ic_get_option(ic, HANGUL_IC_OPTION_TRACE));
+    hangul_ic_set_option(ic, HANGUL_IC_OPTION_TRANSITION_TABLE, true);
+
+    for (i = 0; i < 1000; i++) {
+	seed = seed * 1103515245 + 12345;
+	switch ((seed >> 16) % 40) {
+	case 0:
+	    hangul_ic_reset(ic);
+	    break;
+	case 1:
+	    hangul_ic_flush(ic);
+	    break;
+	case 2:
+	    hangul_ic_backspace(ic);
+	    break;
+	default:
+	    hangul_ic_process(ic, 'a' + (seed >> 8) % 26);
+	    break;
+	}
+    }
+
+    len = hangul_ic_dump_trace(ic, NULL, 0);
+    ck_assert(len > 0 && len < sizeof(dump));
+    ck_assert(hangul_ic_dump_trace(ic, dump, sizeof(dump)) == len);
+    ck_assert(strlen(dump) == len);
+    ck_assert(strncmp(dump, "# libhangul trace\nstate ", 24) == 0);
+
+    /* 기록의 처음 상태에서 같은 이벤트를 처리하면 같은 기록이 나와야 한다 */
+    replay = hangul_ic_new("3f");
+    hangul_ic_set_option(replay, HANGUL_IC_OPTION_TRACE, true);
+    strcpy(dump2, dump);
+    for (line = strtok(dump2, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+	int key;
+
+	if (strncmp(line, "state ", 6) == 0) {
+	    int n;
+	    for (n = 0; line[6 + n * 2] != '\0'; n++) {
+		unsigned int byte;
+		sscanf(line + 6 + n * 2, "%2x", &byte);
+		state[n] = byte;
+	    }
+	    ck_assert(hangul_ic_restore_state(replay, state, n));
+	} else if (strncmp(line, "reset ", 6) == 0) {
+	    hangul_ic_reset(replay);
+	    nevents++;
+	} else if (strncmp(line, "flush ", 6) == 0) {
+	    hangul_ic_flush(replay);
+	    nevents++;
+	} else if (sscanf(line, "key=%d", &key) == 1) {
+	    hangul_ic_process(replay, key);
+	    nevents++;
+	}
+    }
+    ck_assert(nevents >= 128 && nevents < 256);
+
+    ck_assert(hangul_ic_dump_trace(replay, dump2, sizeof(dump2)) == len);
+    ck_assert(strcmp(dump, dump2) == 0);
+
+    /* 버퍼가 부족하면 들어가는 줄까지만 저장한다 */
+    ck_assert(hangul_ic_dump_trace(ic, dump2, 100) == len);
+    ck_assert(strlen(dump2) < 100);
+    ck_assert(strncmp(dump, dump2, strlen(dump2)) == 0);
+
+    hangul_ic_set_option(ic, HANGUL_IC_OPTION_TRACE, false);
+    ck_assert(!hangul_ic_get_option(ic, HANGUL_IC_OPTION_TRACE));
+    ck_assert(hangul_ic_dump_trace(ic, dump2, sizeof(dump2)) == 0);
+
+    hangul_ic_delete(ic);
+    hangul_ic_delete(replay);
+}
+END_TEST
+
+START_TEST(test_hangul_ic_process_keys)
+{
+    HangulInputContext* ic;
+    ucschar out[128];
+    int len;
+    int n;
+
+    ic = get_ic("2");
+
+    /* 한글 입력 */
+    len = 0;
+    n = hangul_ic_process_keys(ic, "gksrmf dlqfur", 13, out, countof(out), &len);
+    ck_assert(n == 13);
+    out[len] = 0;
+    ck_assert(wcscmp((const wchar_t*)out, L"한글 입") == 0);
+    ck_assert(wcscmp((const wchar_t*)hangul_ic_get_preedit_string(ic), L"력") == 0);
+
+    /* 이미 들어 있는 내용 뒤에 붙인다 */
+    n = hangul_ic_process_keys(ic, " ", 1, out, countof(out), &len);
+    ck_assert(n == 1);
+    out[len] = 0;
+    ck_assert(wcscmp((const wchar_t*)out, L"한글 입력 ") == 0);
+
+    /* 버퍼가 부족하면 처리하지 않는다 */
+    hangul_ic_reset(ic);
+    len = 0;
+    n = hangul_ic_process_keys(ic, "rk", 2, out, 8, &len);
+    ck_assert(n == 0);
+    ck_assert(len == 0);
+
+    /* ASCII 이외의 키를 만나면 멈춘다 */
+    len = 0;
+    n = hangul_ic_process_keys(ic, "rk\xed\x95\x9c", 5, out, countof(out), &len);
+    ck_assert(n == 2);
+    ck_assert(len == 0);
+    ck_assert(wcscmp((const wchar_t*)hangul_ic_get_preedit_string(ic), L"가") == 0);
+}
+END_TEST
+
+START_TEST(test_hangul_ucs4_to_utf8)
+{
+    HangulInputContext* ic;
+    const ucschar str[] = { 'a', 0xe9, 0xac00, 0xd800, 0x1f600, 0x110000, 0 };
+    char buf[16];
+    int n;
+
+    n = hangul_ucs4_to_utf8(buf, sizeof(buf), str, -1);
+    ck_assert_int_eq(n, 10);
+    ck_assert_str_eq(buf, "a\xc3\xa9\xea\xb0\x80\xf0\x9f\x98\x80");
+
+    /* 글자 중간에서 자르지 않는다 */
+    n = hangul_ucs4_to_utf8(buf, 5, str, -1);
+    ck_assert_int_eq(n, 3);
+    ck_assert_str_eq(buf, "a\xc3\xa9");
+
+    n = hangul_ucs4_to_utf8(buf, sizeof(buf), str, 1);
+    ck_assert_int_eq(n, 1);
+    ck_assert_str_eq(buf, "a");
+
+    ic = get_ic("2");
+    hangul_ic_process(ic, 'g');
+    hangul_ic_process(ic, 'k');
+    hangul_ic_process(ic, 's');
+    n = hangul_ic_get_preedit_string_utf8(ic, buf, sizeof(buf));
+    ck_assert_int_eq(n, 3);
+    ck_assert_str_eq(buf, "한");
+
+    hangul_ic_process(ic, 'r');
+    n = hangul_ic_get_commit_string_utf8(ic, buf, sizeof(buf));
+    ck_assert_int_eq(n, 3);
+    ck_assert_str_eq(buf, "한");
+    hangul_ic_process(ic, 'm');
+    n = hangul_ic_get_preedit_string_utf8(ic, buf, sizeof(buf));
+    ck_assert_str_eq(buf, "그");
+    hangul_ic_reset(ic);
+}
+END_TEST
+
 START_TEST(test_syllable_iterator)
 {
     ucschar str[] = {
@@ -575,10 +1375,311 @@ START_TEST(test_hangul_keyboard)
     );
 
     hangul_keyboard_delete(keyboard);
+
+    /* id로 찾은 자판은 목록의 자판과 같아야 하고, 같은 id의 자판이
+     * 여러개 있으면 나중에 등록한 자판이 선택된다. */
+    for (i = 0; i < n; ++i) {
+	const HangulKeyboard* found;
+
+	id = hangul_keyboard_list_get_keyboard_id(i);
+	found = hangul_keyboard_list_get_keyboard(id);
+	ck_assert_msg(found != NULL, "error: cannot find keyboard: %s", id);
+    }
+    ck_assert(hangul_keyboard_list_get_keyboard("no-such-keyboard") == NULL);
+
+    HangulKeyboard* keyboards[2];
+    for (i = 0; i < countof(keyboards); ++i) {
+	keyboards[i] = hangul_keyboard_new_from_file(TEST_SOURCE_DIR "/recursive.xml");
+	ck_assert(keyboards[i] != NULL);
+	ck_assert(hangul_keyboard_list_register_keyboard(keyboards[i]) != NULL);
+    }
+    ck_assert(hangul_keyboard_list_get_keyboard("recursive") == keyboards[1]);
+    ck_assert(hangul_keyboard_list_get_keyboard("2") != NULL);
+    for (i = 0; i < countof(keyboards); ++i) {
+	ck_assert(hangul_keyboard_list_unregister_keyboard("recursive") == keyboards[i]);
+	hangul_keyboard_delete(keyboards[i]);
+    }
+    ck_assert(hangul_keyboard_list_get_keyboard("recursive") == NULL);
+    ck_assert(hangul_keyboard_list_get_count() == n);
+}
+END_TEST
+
+/* 테스트가 사용자의 ~/.cache 에 자판 캐시를 만들지 않도록, 테스트 동안은
+ * XDG_CACHE_HOME 을 임시 디렉토리로 바꿔 둔다. */
+static char test_cache_home[] = "/tmp/libhangul-test-XXXXXX";
+
+/* cache_home 에 만든 자판 캐시를 지우고 지운 캐시 파일의 수를 리턴한다. */
+static int
+remove_cache_home(const char* cache_home)
+{
+    char cache_dir[256];
+    char file[512];
+    struct dirent* entry;
+    DIR* dir;
+    int ncaches = 0;
+
+    snprintf(cache_dir, sizeof(cache_dir), "%s/libhangul/keyboards", cache_home);
+    dir = opendir(cache_dir);
+    if (dir != NULL) {
+	while ((entry = readdir(dir)) != NULL) {
+	    if (entry->d_name[0] == '.')
+		continue;
+	    snprintf(file, sizeof(file), "%s/%s", cache_dir, entry->d_name);
+	    unlink(file);
+	    ncaches++;
+	}
+	closedir(dir);
+    }
+
+    rmdir(cache_dir);
+    snprintf(cache_dir, sizeof(cache_dir), "%s/libhangul", cache_home);
+    rmdir(cache_dir);
+    rmdir(cache_home);
+    return ncaches;
+}
+
+/* 캐시 파일에서 from 을 찾아서 to 로 바꾼다. */
+static bool
+patch_cache_file(const char* cache_home, const void* from, const void* to,
+		 size_t len)
+{
+    char cache_dir[256];
+    char file[512];
+    struct dirent* entry;
+    DIR* dir;
+    bool patched = false;
+
+    snprintf(cache_dir, sizeof(cache_dir), "%s/libhangul/keyboards", cache_home);
+    dir = opendir(cache_dir);
+    if (dir == NULL)
+	return false;
+
+    while ((entry = readdir(dir)) != NULL) {
+	char buf[65536];
+	size_t n;
+	size_t i;
+	FILE* f;
+
+	if (entry->d_name[0] == '.')
+	    continue;
+
+	snprintf(file, sizeof(file), "%s/%s", cache_dir, entry->d_name);
+	f = fopen(file, "r+b");
+	if (f == NULL)
+	    continue;
+	n = fread(buf, 1, sizeof(buf), f);
+	for (i = 0; i + len <= n; i += 4) {
+	    if (memcmp(buf + i, from, len) == 0) {
+		fseek(f, i, SEEK_SET);
+		fwrite(to, 1, len, f);
+		patched = true;
+		break;
+	    }
+	}
+	fclose(f);
+    }
+    closedir(dir);
+
+    return patched;
+}
+
+/* 자판 목록은 자판 파일의 앞부분만 읽어서 만든다. 이름이 테이블 뒤에
+ * 있는 파일과 이름이 없는 파일도 이름을 찾을 수 있어야 한다. */
+START_TEST(test_hangul_keyboard_list_name)
+{
+    char dir[] = "/tmp/libhangul-test-XXXXXX";
+    char file[2][256];
+    const char* contents[2] = {
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<hangul-keyboard id=\"late-name\" type=\"jamo\">\n"
+	"  <map id=\"0\">\n"
+	"    <item key=\"0x6b\" value=\"0x1100\"/>\n"
+	"  </map>\n"
+	"  <include file=\"" TEST_LIBHANGUL_KEYBOARD_PATH "/hangul-combination-default.xml\"/>\n",
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<hangul-keyboard id=\"no-name\" type=\"jamo\">\n"
+	"  <map id=\"0\">\n"
+	"    <item key=\"0x6b\" value=\"0x1100\"/>\n"
+	"  </map>\n"
+	"</hangul-keyboard>\n",
+    };
+    const char* late_name =
+	"  <name>Late Name</name>\n"
+	"</hangul-keyboard>\n";
+    const char* names[2] = { NULL, NULL };
+    HangulInputContext* ic;
+    unsigned n;
+    unsigned i;
+    int j;
+
+    ck_assert(mkdtemp(dir) != NULL);
+    for (i = 0; i < countof(file); ++i) {
+	FILE* f;
+	snprintf(file[i], sizeof(file[i]), "%s/%s.xml", dir, i == 0 ? "late-name" : "no-name");
+	f = fopen(file[i], "w");
+	ck_assert(f != NULL);
+	fputs(contents[i], f);
+	if (i == 0) {
+	    /* 이름이 파일을 읽는 버퍼 크기보다 뒤에 있게 한다. */
+	    for (j = 0; j < 200; ++j)
+		fputs("  <!-- ..................................................... -->\n", f);
+	    fputs(late_name, f);
+	}
+	fclose(f);
+    }
+
+    hangul_fini();
+    hangul_init(dir);
+
+    n = hangul_keyboard_list_get_count();
+    for (i = 0; i < n; ++i) {
+	const char* id = hangul_keyboard_list_get_keyboard_id(i);
+	if (strcmp(id, "late-name") == 0)
+	    names[0] = hangul_keyboard_list_get_keyboard_name(i);
+	else if (strcmp(id, "no-name") == 0)
+	    names[1] = hangul_keyboard_list_get_keyboard_name(i);
+    }
+    ck_assert(names[0] != NULL && strcmp(names[0], "Late Name") == 0);
+    ck_assert(names[1] != NULL && strcmp(names[1], "no-name") == 0);
+
+    /* 테이블은 자판을 선택할 때 읽는다. */
+    ic = hangul_ic_new("late-name");
+    ck_assert(check_preedit_with_ic(ic, "k", L"ㄱ"));
+    hangul_ic_delete(ic);
+
+    hangul_fini();
+    hangul_init(TEST_LIBHANGUL_KEYBOARD_PATH);
+
+    for (i = 0; i < countof(file); ++i)
+	unlink(file[i]);
+    rmdir(dir);
+}
+END_TEST
+
+START_TEST(test_hangul_keyboard_cache)
+{
+    const char* path = TEST_LIBHANGUL_KEYBOARD_PATH "/hangul-keyboard-3f.xml";
+    char cache_home[] = "/tmp/libhangul-test-XXXXXX";
+    /* 세벌식 최종의 j k l 자리: ㅇ ㄱ ㅈ */
+    const ucschar jkl[] = { 0x110b, 0x1100, 0x110c };
+    const ucschar jkl_broken[] = { 0x110b, 0x110f, 0x110c };
+    HangulKeyboard* keyboard;
+    HangulInputContext* ic;
+    int i;
+
+    /* ic 가 선택하는 자판이 이 캐시 디렉토리에 저장되지 않도록 먼저
+     * 만든다. */
+    ic = hangul_ic_new("2");
+
+    ck_assert(mkdtemp(cache_home) != NULL);
+    setenv("XDG_CACHE_HOME", cache_home, 1);
+
+    /* 처음에는 XML 파일을 읽어서 캐시를 만들고, 다음에는 캐시에서 읽는다.
+     * 두 자판은 같은 결과를 내야 한다.
+     * 마지막에는 캐시의 자판 테이블을 바꿔서 깨뜨려 둔다. 체크섬이 맞지
+     * 않으므로 캐시를 버리고 XML 파일을 다시 읽어야 한다. */
+    for (i = 0; i < 3; ++i) {
+	if (i == 2)
+	    ck_assert(patch_cache_file(cache_home, jkl, jkl_broken, sizeof(jkl)));
+
+	keyboard = hangul_keyboard_new_from_file(path);
+	ck_assert(keyboard != NULL);
+
+	hangul_ic_set_keyboard(ic, keyboard);
+	ck_assert(check_preedit_with_ic(ic, "kfa", L"강"));
+	hangul_ic_reset(ic);
+	/* 조합 테이블: ㄱ ㅗ ㅏ */
+	ck_assert(check_preedit_with_ic(ic, "kvf", L"과"));
+	hangul_ic_reset(ic);
+	hangul_keyboard_delete(keyboard);
+    }
+    hangul_ic_delete(ic);
+    setenv("XDG_CACHE_HOME", test_cache_home, 1);
+
+    ck_assert(remove_cache_home(cache_home) == 1);
+}
+END_TEST
+
+/* 같은 조합 파일을 include 하는 자판은 조합 테이블을 공유해야 한다.
+ * XML 에서 읽을 때와 캐시에서 읽을 때 모두 확인한다. */
+START_TEST(test_hangul_keyboard_shared_combination)
+{
+    const char* paths[] = {
+	TEST_LIBHANGUL_KEYBOARD_PATH "/hangul-keyboard-3f.xml",
+	TEST_LIBHANGUL_KEYBOARD_PATH "/hangul-keyboard-39.xml",
+    };
+    char cache_home[] = "/tmp/libhangul-test-XXXXXX";
+    HangulKeyboard* keyboards[2][2];
+    int i;
+
+    ck_assert(mkdtemp(cache_home) != NULL);
+    setenv("XDG_CACHE_HOME", cache_home, 1);
+
+    for (i = 0; i < 2; ++i) {
+	keyboards[i][0] = hangul_keyboard_new_from_file(paths[0]);
+	keyboards[i][1] = hangul_keyboard_new_from_file(paths[1]);
+	ck_assert(keyboards[i][0] != NULL);
+	ck_assert(keyboards[i][1] != NULL);
+	ck_assert(hangul_keyboard_get_combination(keyboards[i][0], 0) != NULL);
+	ck_assert(hangul_keyboard_get_combination(keyboards[i][0], 0) ==
+		  hangul_keyboard_get_combination(keyboards[i][1], 0));
+    }
+    ck_assert(hangul_keyboard_get_combination(keyboards[0][0], 0) ==
+	      hangul_keyboard_get_combination(keyboards[1][0], 0));
+
+    for (i = 0; i < 2; ++i) {
+	hangul_keyboard_delete(keyboards[i][0]);
+	hangul_keyboard_delete(keyboards[i][1]);
+    }
+    setenv("XDG_CACHE_HOME", test_cache_home, 1);
+
+    ck_assert(remove_cache_home(cache_home) == 2);
 }
 END_TEST
 #endif /* ENABLE_EXTERNAL_KEYBOARDS */
 
+/* 설명은 처음 찾아볼 때 사전 파일에서 읽는다. 줄 끝이 CRLF 인 사전에서도
+ * 위치가 맞아야 한다. */
+START_TEST(test_hanja_comment)
+{
+    HanjaTable* table;
+    HanjaList* list;
+    HanjaList* list2;
+
+    table = hanja_table_load(TEST_SOURCE_DIR "/hanja-crlf.txt");
+    ck_assert(table != NULL);
+
+    list = hanja_table_match_exact(table, "가격");
+    ck_assert(hanja_list_get_size(list) == 2);
+    ck_assert(hanja_table_get_stats(table, HANJA_TABLE_STATS_COMMENT_LOADS) == 0);
+    ck_assert_str_eq(hanja_list_get_nth_comment(list, 1), "집안의 격");
+    ck_assert(hanja_table_get_stats(table, HANJA_TABLE_STATS_COMMENT_LOADS) == 1);
+    ck_assert_str_eq(hanja_list_get_nth_comment(list, 1), "집안의 격");
+    ck_assert(hanja_table_get_stats(table, HANJA_TABLE_STATS_COMMENT_LOADS) == 1);
+    ck_assert_str_eq(hanja_list_get_nth_value(list, 0), "價格");
+
+    list2 = hanja_table_match_exact(table, "나");
+    ck_assert(hanja_list_get_size(list2) == 2);
+    ck_assert_str_eq(hanja_list_get_nth_comment(list2, 0), "");
+    ck_assert_str_eq(hanja_list_get_nth_comment(list2, 1), "어찌 나");
+    hanja_list_delete(list2);
+
+    /* 사전을 삭제해도 검색 결과에서 설명을 읽을 수 있다 */
+    hanja_table_delete(table);
+    ck_assert_str_eq(hanja_list_get_nth_comment(list, 0), "물건의 값");
+    hanja_list_delete(list);
+
+    table = hanja_table_load(TEST_SOURCE_DIR "/hanja-crlf.txt");
+    list = hanja_table_match_prefix(table, "가");
+    ck_assert(hanja_list_get_size(list) == 3);
+    ck_assert_str_eq(hanja_list_get_nth_comment(list, 2), "옳을 가");
+    ck_assert_str_eq(hanja_list_get_nth_comment(list, 0), "집 가");
+    ck_assert_str_eq(hanja_list_get_nth_comment(list, 1), "더할 가");
+    hanja_list_delete(list);
+    hanja_table_delete(table);
+}
+END_TEST
+
 START_TEST(test_hangul_jamo_to_cjamo)
 {
     ck_assert(
@@ -606,10 +1707,26 @@ Suite* libhangul_suite()
     tcase_add_test(hangul, test_hangul_ic_auto_reorder);
     tcase_add_test(hangul, test_hangul_ic_combi_on_double_stroke);
     tcase_add_test(hangul, test_hangul_ic_non_choseong_combi);
+    tcase_add_test(hangul, test_hangul_ic_commit_callback);
+    tcase_add_test(hangul, test_hangul_ic_string_length);
+    tcase_add_test(hangul, test_hangul_ic_transition_table);
+    tcase_add_test(hangul, test_hangul_ic_transition_table_keyboard_change);
+    tcase_add_test(hangul, test_hangul_ic_pool);
+    tcase_add_test(hangul, test_hangul_ic_save_state);
+    tcase_add_test(hangul, test_hangul_ic_restore_malformed_state);
+    tcase_add_test(hangul, test_hangul_ic_process_ex);
+    tcase_add_test(hangul, test_hangul_ic_process_keys);
+    tcase_add_test(hangul, test_hangul_ic_trace);
+    tcase_add_test(hangul, test_hangul_ic_process_batch);
+    tcase_add_test(hangul, test_hangul_ucs4_to_utf8);
     tcase_add_test(hangul, test_syllable_iterator);
 #if ENABLE_EXTERNAL_KEYBOARDS
     tcase_add_test(hangul, test_hangul_keyboard);
+    tcase_add_test(hangul, test_hangul_keyboard_list_name);
+    tcase_add_test(hangul, test_hangul_keyboard_cache);
+    tcase_add_test(hangul, test_hangul_keyboard_shared_combination);
 #endif /* ENABLE_EXTERNAL_KEYBOARDS */
+    tcase_add_test(hangul, test_hanja_comment);
     tcase_add_test(hangul, test_hangul_jamo_to_cjamo);
     suite_add_tcase(s, hangul);
 
@@ -619,6 +1736,9 @@ Suite* libhangul_suite()
 int main()
 {
 #if ENABLE_EXTERNAL_KEYBOARDS
+    if (mkdtemp(test_cache_home) == NULL)
+	return EXIT_FAILURE;
+    setenv("XDG_CACHE_HOME", test_cache_home, 1);
     hangul_init(TEST_LIBHANGUL_KEYBOARD_PATH);
 #endif // ENABLE_EXTERNAL_KEYBOARDS
 
@@ -636,6 +1756,7 @@ int main()
 
 #if ENABLE_EXTERNAL_KEYBOARDS
     hangul_fini();
+    remove_cache_home(test_cache_home);
 #endif // ENABLE_EXTERNAL_KEYBOARDS
 
     return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
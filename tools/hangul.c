@@ -28,28 +28,36 @@
 #include <locale.h>
 #include <getopt.h>
 #include <errno.h>
+#include <limits.h>
+#include <pthread.h>
 
 #ifdef HAVE_LANGINFO_H
 #include <langinfo.h>
 #endif
 
-#include <iconv.h>
-
 #include "../hangul/hangul.h"
 #include "../hangul/hangul-gettext.h"
 
-#ifdef WORDS_BIGENDIAN
-#define UCS4  "UCS-4BE"
-#else
-#define UCS4  "UCS-4LE"
-#endif
+#define N_ELEMENTS(array) (sizeof (array) / sizeof ((array)[0]))
 
-#ifndef ICONV_CONST
-#define ICONV_CONST
-#endif
+/* 병렬 모드에서 스레드 하나가 한번에 처리하는 입력의 크기 */
+#define HANGUL_JOB_CHUNK_SIZE (1024 * 1024)
+
+typedef struct _HangulJob HangulJob;
+
+struct _HangulJob {
+    pthread_t thread;
+    const char* keyboard;
+    bool strict_order;
+    bool flush;
+    const char* input;
+    size_t input_len;
+    char* output;
+    size_t output_len;
+    int error;
+};
 
 static const char* program_name = "hangul";
-static iconv_t cd_ucs4_to_utf8 = (iconv_t)-1;
 
 static void
 print_error(int status, int errnum, const char* format, ...)
@@ -84,6 +92,10 @@ Mandatory arguments to long options are mandatory for short options too.\n\
   -s, --strict-order          do not allow wrong input sequence\n\
 "), stdout);
 
+	fputs(_("\
+  -j, --jobs=N                convert input in N threads (0: one per CPU)\n\
+"), stdout);
+
 	fputs(_("\
       --help                  display this help and exit\n\
       --version               output version information and exit\n\
@@ -156,78 +168,120 @@ list_keyboards()
     exit(EXIT_SUCCESS);
 }
 
-size_t ucschar_strlen(const ucschar* str)
+static int
+fwrite_ucschar(const ucschar* str, size_t len, FILE* stream)
 {
-    const ucschar* p = str;
-    while (p[0] != 0) {
-	p++;
+    char buf[512];
+    /* 한 글자는 UTF-8로 4바이트를 넘지 않으므로 이만큼은 한번에 변환된다. */
+    const size_t max_chars = (sizeof(buf) - 1) / 4;
+
+    while (len > 0) {
+	size_t n = len < max_chars ? len : max_chars;
+	int nbytes = hangul_ucs4_to_utf8(buf, sizeof(buf), str, n);
+	if (nbytes > 0) {
+	    if (fwrite(buf, 1, nbytes, stream) != nbytes)
+		return EOF;
+	}
+
+	str += n;
+	len -= n;
     }
 
-    return p - str;
+    return 0;
 }
 
+/* 조합중인 글자를 완성하여 출력한다. */
 static int
-fputs_ucschar(const ucschar* str, FILE* stream)
+hangul_flush(HangulInputContext* ic, FILE* stream)
 {
-    char buf[512];
-    ICONV_CONST char* inbuf;
-    char* outbuf;
-    size_t inbytesleft;
-    size_t outbytesleft;
-    size_t len;
-    size_t res;
-
-    len = ucschar_strlen(str);
-
-    inbuf = (char*)str;
-    outbuf = buf;
-    inbytesleft = len * 4;
-    outbytesleft = sizeof(buf) - 1;
-
-    res = iconv(cd_ucs4_to_utf8, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
-    if (res == -1) {
-	if (errno == E2BIG) {
-	} else if (errno == EILSEQ) {
-	} else if (errno == EINVAL) {
-	}
-    }
-    
-    *outbuf = '\0';
+    int len;
+    const ucschar* str = hangul_ic_flush_len(ic, &len);
+
+    if (len > 0)
+	return fwrite_ucschar(str, len, stream);
 
-    return fputs(buf, stream);
+    return 0;
 }
 
-static void
-hangul_process_with_string(HangulInputContext* ic, const char* input, FILE* output)
+/* 키 입력 n개를 변환하여 출력한다.
+ * hangul_ic_process_keys()가 처리하지 못하는 ASCII 이외의 바이트는
+ * 조합중인 글자를 완성한 후 그대로 출력한다. */
+static int
+hangul_process_keys(HangulInputContext* ic, const char* input, size_t n,
+		    FILE* output)
 {
+    ucschar buf[1024];
     int r;
-    const ucschar* str;
 
-    while (*input != '\0') {
-	bool is_processed = hangul_ic_process(ic, *input);
-	str = hangul_ic_get_commit_string(ic);
-	if (str[0] != 0) {
-	    r = fputs_ucschar(str, output);
+    while (n > 0) {
+	int len = 0;
+	int nkeys = n > INT_MAX ? INT_MAX : n;
+	int consumed = hangul_ic_process_keys(ic, input, nkeys,
+					      buf, N_ELEMENTS(buf), &len);
+	if (len > 0) {
+	    r = fwrite_ucschar(buf, len, output);
 	    if (r == EOF)
-		goto on_error;
+		return EOF;
 	}
-	if (!is_processed) {
-	    r = fputc(*input, output);
+
+	input += consumed;
+	n -= consumed;
+
+	if (n > 0 && (unsigned char)input[0] >= 0x80) {
+	    r = hangul_flush(ic, output);
 	    if (r == EOF)
-		goto on_error;
-	}
+		return EOF;
+
+	    r = fputc(input[0], output);
+	    if (r == EOF)
+		return EOF;
 
-	input++;
+	    input++;
+	    n--;
+	}
     }
 
-    str = hangul_ic_flush(ic);
-    if (str[0] != 0) {
-	r = fputs_ucschar(str, output);
+    return 0;
+}
+
+static void
+hangul_process_with_string(HangulInputContext* ic, const char* input, FILE* output)
+{
+    int r;
+
+    r = hangul_process_keys(ic, input, strlen(input), output);
+    if (r == EOF)
+	goto on_error;
+
+    r = hangul_flush(ic, output);
+    if (r == EOF)
+	goto on_error;
+
+    r = fputs("\n", output);
+    if (r == EOF)
+	goto on_error;
+
+    return;
+
+on_error:
+    print_error(0, errno, _("standard output"));
+    exit(EXIT_FAILURE);
+}
+
+static void
+hangul_process(HangulInputContext* ic, FILE* input, FILE* output)
+{
+    int r;
+    size_t n;
+    char buf[8192];
+
+    while ((n = fread(buf, 1, sizeof(buf), input)) > 0) {
+	r = hangul_process_keys(ic, buf, n, output);
 	if (r == EOF)
 	    goto on_error;
     }
 
-    r = fputs("\n", output);
+    r = hangul_flush(ic, output);
     if (r == EOF)
 	goto on_error;
 
@@ -238,40 +292,233 @@ on_error:
     exit(EXIT_FAILURE);
 }
 
+static HangulInputContext*
+hangul_ic_new_with_options(const char* keyboard, bool strict_order)
+{
+    HangulInputContext* ic = hangul_ic_new(keyboard);
+    if (ic == NULL)
+	return NULL;
+
+    if (strict_order) {
+	hangul_ic_set_option(ic, HANGUL_IC_OPTION_AUTO_REORDER, false);
+    } else {
+	hangul_ic_set_option(ic, HANGUL_IC_OPTION_AUTO_REORDER, true);
+    }
+
+    /* 많은 입력을 한번에 변환하므로 상태 전이표를 사용한다. */
+    hangul_ic_set_option(ic, HANGUL_IC_OPTION_TRANSITION_TABLE, true);
+
+    return ic;
+}
+
+/* 어떤 상태에서 입력하더라도 처리후에 입력 context가 비게 되는 키를 찾는다.
+ * 자모에 대응되지 않는 키는 조합중인 글자를 완성하므로, 빈 context에
+ * 한번 입력해보고 비어 있으면 그런 키로 본다.
+ * 백스페이스는 이전 상태를 되살리므로 제외한다.
+ * ASCII 이외의 바이트는 hangul_process_keys()가 flush한 후 출력하므로
+ * 항상 경계가 될 수 있다. */
 static void
-hangul_process(HangulInputContext* ic, FILE* input, FILE* output)
+find_reset_keys(const char* keyboard, bool reset[256])
+{
+    HangulInputContext* ic;
+    int i;
+
+    for (i = 0; i < 256; i++)
+	reset[i] = i >= 0x80;
+
+    ic = hangul_ic_new(keyboard);
+    if (ic == NULL)
+	return;
+
+    for (i = 1; i < 0x80; i++) {
+	if (i == '\b')
+	    continue;
+
+	hangul_ic_reset(ic);
+	hangul_ic_process(ic, i);
+	reset[i] = hangul_ic_is_empty(ic);
+    }
+
+    hangul_ic_delete(ic);
+}
+
+/* [begin, end) 범위에서 처음 나오는 경계 키의 다음 위치를 찾는다.
+ * 없으면 end를 리턴한다. */
+static size_t
+find_next_boundary(const char* buf, size_t begin, size_t end,
+		   const bool reset[256])
 {
+    size_t i;
+
+    for (i = begin; i < end; i++) {
+	if (reset[(unsigned char)buf[i]])
+	    return i + 1;
+    }
+
+    return end;
+}
+
+/* 마지막 경계 키의 다음 위치를 찾는다. 없으면 0을 리턴한다. */
+static size_t
+find_last_boundary(const char* buf, size_t len, const bool reset[256])
+{
+    size_t i;
+
+    for (i = len; i > 0; i--) {
+	if (reset[(unsigned char)buf[i - 1]])
+	    return i;
+    }
+
+    return 0;
+}
+
+static void*
+hangul_job_run(void* data)
+{
+    HangulJob* job = data;
+    HangulInputContext* ic = NULL;
+    FILE* stream = NULL;
     int r;
-    int c;
-    const ucschar* str;
-
-    c = fgetc(input);
-    while (c != EOF) {
-	bool res = hangul_ic_process(ic, c);
-	str = hangul_ic_get_commit_string(ic);
-	if (str[0] != 0) {
-	    r = fputs_ucschar(str, output);
-	    if (r == EOF)
-		goto on_error;
-	}
-	if (!res) {
-	    r = fputc(c, output);
-	    if (r == EOF)
-		goto on_error;
-	}
 
-	c = fgetc(input);
+    job->output = NULL;
+    job->output_len = 0;
+    job->error = 0;
+
+    ic = hangul_ic_new_with_options(job->keyboard, job->strict_order);
+    stream = open_memstream(&job->output, &job->output_len);
+    if (ic == NULL || stream == NULL) {
+	job->error = errno;
+	goto done;
+    }
+
+    r = hangul_process_keys(ic, job->input, job->input_len, stream);
+    if (r == EOF) {
+	job->error = errno;
+	goto done;
     }
 
-    str = hangul_ic_flush(ic);
-    if (str[0] != 0) {
-	r = fputs_ucschar(str, output);
+    if (job->flush) {
+	r = hangul_flush(ic, stream);
 	if (r == EOF)
-	    goto on_error;
+	    job->error = errno;
     }
 
+done:
+    if (stream != NULL) {
+	if (fclose(stream) != 0 && job->error == 0)
+	    job->error = errno;
+    }
+    if (ic != NULL)
+	hangul_ic_delete(ic);
+
+    return NULL;
+}
+
+/* 입력을 블럭 단위로 읽어서 입력 context가 비게 되는 경계에서 나누고
+ * 각 조각을 별도의 스레드에서 변환한다.
+ * 결과는 입력 순서대로 출력하므로 hangul_process()와 같다. */
+static void
+hangul_process_parallel(const char* keyboard, bool strict_order,
+			FILE* input, FILE* output, int jobs)
+{
+    bool reset[256];
+    HangulJob* job;
+    char* buf = NULL;
+    size_t buf_size = 0;
+    size_t len = 0;
+    size_t block = (size_t)jobs * HANGUL_JOB_CHUNK_SIZE;
+    bool eof = false;
+    int njobs;
+    int i;
+
+    find_reset_keys(keyboard, reset);
+
+    job = calloc(jobs, sizeof(job[0]));
+    if (job == NULL)
+	goto on_memory_error;
+
+    while (!eof) {
+	size_t n;
+	size_t end;
+	size_t begin;
+
+	if (buf_size < len + block) {
+	    char* p = realloc(buf, len + block);
+	    if (p == NULL)
+		goto on_memory_error;
+	    buf = p;
+	    buf_size = len + block;
+	}
+
+	n = fread(buf + len, 1, block, input);
+	len += n;
+	if (n < block)
+	    eof = true;
+
+	/* 경계가 없으면 더 읽어서 붙인다. */
+	end = eof ? len : find_last_boundary(buf, len, reset);
+	if (end == 0)
+	    continue;
+
+	/* 중간 이후에 경계가 없으면 앞의 작업이 끝까지 처리하므로 남은
+	 * 작업은 만들지 않는다. 마지막 조각을 처리하는 작업이 flush 해야
+	 * 한다. */
+	begin = 0;
+	for (njobs = 0; njobs < jobs && begin < end; njobs++) {
+	    size_t next;
+
+	    i = njobs;
+	    if (i == jobs - 1)
+		next = end;
+	    else
+		next = find_next_boundary(buf, begin + (end - begin) / (jobs - i),
+					  end, reset);
+
+	    job[i].keyboard = keyboard;
+	    job[i].strict_order = strict_order;
+	    job[i].flush = eof && next == end;
+	    job[i].input = buf + begin;
+	    job[i].input_len = next - begin;
+	    if (pthread_create(&job[i].thread, NULL, hangul_job_run, &job[i]) != 0) {
+		/* 스레드를 만들 수 없으면 여기서 처리한다. */
+		hangul_job_run(&job[i]);
+		job[i].thread = pthread_self();
+	    }
+
+	    begin = next;
+	}
+
+	for (i = 0; i < njobs; i++) {
+	    if (!pthread_equal(job[i].thread, pthread_self()))
+		pthread_join(job[i].thread, NULL);
+	}
+
+	for (i = 0; i < njobs; i++) {
+	    int error = job[i].error;
+
+	    if (error == 0 && job[i].output_len > 0) {
+		if (fwrite(job[i].output, 1, job[i].output_len, output) != job[i].output_len)
+		    error = errno;
+	    }
+	    free(job[i].output);
+	    job[i].output = NULL;
+
+	    if (error != 0) {
+		errno = error;
+		goto on_error;
+	    }
+	}
+
+	memmove(buf, buf + end, len - end);
+	len -= end;
+    }
+
+    free(buf);
+    free(job);
     return;
 
+on_memory_error:
+    errno = ENOMEM;
 on_error:
     print_error(0, errno, _("standard output"));
     exit(EXIT_FAILURE);
@@ -288,6 +535,7 @@ main(int argc, char *argv[])
     FILE* output;
     HangulInputContext* ic;
     bool strict_order = false;
+    long jobs = 1;
 
 #ifdef ENABLE_NLS
     bindtextdomain(GETTEXT_PACKAGE, LOCALEDIR);
@@ -307,12 +555,13 @@ main(int argc, char *argv[])
 	    { "input",       required_argument,  NULL, 'i' },
 	    { "output",      required_argument,  NULL, 'o' },
 	    { "strict-order",no_argument,        NULL, 's' },
+	    { "jobs",        required_argument,  NULL, 'j' },
 	    { "help",        no_argument,        NULL, 'h' },
 	    { "version",     no_argument,        NULL, 'v' },
 	    { NULL,          0,                  NULL, 0   }
 	};
 
-	c = getopt_long(argc, argv, "k:li:o:s", long_options, NULL);
+	c = getopt_long(argc, argv, "k:li:o:sj:", long_options, NULL);
 	if (c == -1)
 	    break;
 
@@ -332,6 +581,15 @@ main(int argc, char *argv[])
 	case 's':
 	    strict_order = true;
 	    break;
+	case 'j':
+	    jobs = strtol(optarg, NULL, 10);
+	    if (jobs <= 0)
+		jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	    if (jobs <= 0)
+		jobs = 1;
+	    else if (jobs > 256)
+		jobs = 256;
+	    break;
 	case 'h':
 	    usage(EXIT_SUCCESS);
 	    break;
@@ -353,19 +611,7 @@ main(int argc, char *argv[])
 	}
     }
 
-    cd_ucs4_to_utf8 = iconv_open("UTF-8", UCS4);
-    if (cd_ucs4_to_utf8 == (iconv_t)-1) {
-	print_error(EXIT_FAILURE, errno, _("conversion from %s to UTF-8"), UCS4);
-	exit(EXIT_FAILURE);
-    }
-
-    ic = hangul_ic_new(keyboard);
-
-    if (strict_order) {
-	hangul_ic_set_option(ic, HANGUL_IC_OPTION_AUTO_REORDER, false);
-    } else {
-	hangul_ic_set_option(ic, HANGUL_IC_OPTION_AUTO_REORDER, true);
-    }
+    ic = hangul_ic_new_with_options(keyboard, strict_order);
 
     if (input_string != NULL) {
 	hangul_process_with_string(ic, input_string, output);
@@ -376,25 +622,32 @@ main(int argc, char *argv[])
 	    FILE* input = NULL;
 	    if (strcmp(argv[i], "-") == 0) {
 		input = stdin;
-		hangul_process(ic, input, output);
+		if (jobs > 1)
+		    hangul_process_parallel(keyboard, strict_order, input, output, jobs);
+		else
+		    hangul_process(ic, input, output);
 	    } else {
 		input = fopen(argv[i], "r");
 		if (input == NULL) {
 		    print_error(0, errno, "%s", argv[i]);
 		} else {
-		    hangul_process(ic, input, output);
+		    if (jobs > 1)
+			hangul_process_parallel(keyboard, strict_order, input, output, jobs);
+		    else
+			hangul_process(ic, input, output);
 		    fclose(input);
 		}
 	    }
 	}
     } else if (input_string == NULL) {
-	hangul_process(ic, stdin, output);
+	if (jobs > 1)
+	    hangul_process_parallel(keyboard, strict_order, stdin, output, jobs);
+	else
+	    hangul_process(ic, stdin, output);
     }
 
     hangul_ic_delete(ic);
 
-    iconv_close(cd_ucs4_to_utf8);
-
     if (strcmp(output_file, "-") != 0) {
 	fclose(output);
     }
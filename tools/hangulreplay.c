@@ -0,0 +1,286 @@
+/* libhangul
+ * Copyright (C) 2026 Choe Hwanjin
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/* 키 입력 기록 재현 도구
+ *
+ * HANGUL_IC_OPTION_TRACE 로 기록하고 hangul_ic_dump_trace() 로 저장한
+ * 파일을 읽어서, 기록의 처음 상태에서 같은 이벤트를 다시 처리한다.
+ * 재현하는 동안에도 기록을 켜 두었다가 마지막에 원래 기록과 줄 단위로
+ * 비교하므로, 라이브러리가 바뀌어서 조합 결과가 달라지면 처음 달라진
+ * 이벤트를 알려준다. */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+
+#include "../hangul/hangul.h"
+
+typedef struct {
+    char** lines;
+    size_t n;
+    size_t alloc;
+} LineList;
+
+static const char* program_name = "hangul-replay";
+
+static void
+usage(int status)
+{
+    fprintf(status == EXIT_SUCCESS ? stdout : stderr,
+	    "Usage: %s [-v] [TRACEFILE]\n"
+	    "Replay a key trace written by hangul_ic_dump_trace().\n"
+	    "\n"
+	    "  -v    print commit and preedit strings for each event\n"
+	    "  -h    display this help and exit\n",
+	    program_name);
+    exit(status);
+}
+
+static void
+line_list_append(LineList* list, const char* line)
+{
+    if (list->n >= list->alloc) {
+	size_t n = list->alloc == 0 ? 256 : list->alloc * 2;
+	char** lines = realloc(list->lines, n * sizeof(lines[0]));
+	if (lines == NULL)
+	    return;
+	list->lines = lines;
+	list->alloc = n;
+    }
+
+    list->lines[list->n++] = strdup(line);
+}
+
+/* 주석과 빈 줄은 빼고 줄 끝의 개행 문자를 지워서 모은다. */
+static void
+line_list_add(LineList* list, char* line)
+{
+    line[strcspn(line, "\r\n")] = '\0';
+    if (line[0] == '#' || line[0] == '\0')
+	return;
+    line_list_append(list, line);
+}
+
+static void
+line_list_load(LineList* list, FILE* file)
+{
+    char buf[1024];
+
+    while (fgets(buf, sizeof(buf), file) != NULL)
+	line_list_add(list, buf);
+}
+
+static void
+line_list_free(LineList* list)
+{
+    size_t i;
+
+    for (i = 0; i < list->n; i++)
+	free(list->lines[i]);
+    free(list->lines);
+}
+
+static int
+hex_decode(const char* hex, unsigned char* buf, int buflen)
+{
+    int len = 0;
+    unsigned int byte;
+
+    while (hex[0] != '\0' && hex[1] != '\0' && len < buflen) {
+	if (sscanf(hex, "%2x", &byte) != 1)
+	    return -1;
+	buf[len++] = byte;
+	hex += 2;
+    }
+
+    return hex[0] == '\0' ? len : -1;
+}
+
+/* 기록할 때 자판으로 바꾼 글자를 그대로 사용한다. translate 콜백으로
+ * 자판을 바꾼 경우도 재현하기 위해서다. */
+static void
+on_translate(HangulInputContext* hic, int ascii, ucschar* ch, void* data)
+{
+    (void)hic;
+    (void)ascii;
+    *ch = *(const ucschar*)data;
+}
+
+static void
+print_ucs4(const char* label, const ucschar* str)
+{
+    char buf[256];
+
+    hangul_ucs4_to_utf8(buf, sizeof(buf), str, -1);
+    printf(" %s=\"%s\"", label, buf);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char* trace_file = NULL;
+    bool verbose = false;
+    LineList lines = { NULL, 0, 0 };
+    unsigned char state[HANGUL_IC_STATE_SIZE_MAX];
+    int state_len;
+    HangulInputContext* hic;
+    ucschar translated = 0;
+    LineList replayed = { NULL, 0, 0 };
+    char* dump;
+    int dump_len;
+    FILE* file;
+    size_t i;
+    int status = EXIT_SUCCESS;
+    int c;
+
+    while ((c = getopt(argc, argv, "vh")) != -1) {
+	switch (c) {
+	case 'v':
+	    verbose = true;
+	    break;
+	case 'h':
+	    usage(EXIT_SUCCESS);
+	    break;
+	default:
+	    usage(EXIT_FAILURE);
+	}
+    }
+
+    if (optind < argc)
+	trace_file = argv[optind];
+
+    if (trace_file == NULL || strcmp(trace_file, "-") == 0) {
+	file = stdin;
+    } else {
+	file = fopen(trace_file, "r");
+	if (file == NULL) {
+	    fprintf(stderr, "%s: %s: %s\n", program_name, trace_file,
+		    strerror(errno));
+	    return EXIT_FAILURE;
+	}
+    }
+    line_list_load(&lines, file);
+    if (file != stdin)
+	fclose(file);
+
+    if (lines.n == 0 || strncmp(lines.lines[0], "state ", 6) != 0) {
+	fprintf(stderr, "%s: no state line in the trace\n", program_name);
+	line_list_free(&lines);
+	return EXIT_FAILURE;
+    }
+
+    /* 외부 자판으로 기록한 것도 재현할 수 있도록 자판 파일을 읽는다. */
+#if ENABLE_EXTERNAL_KEYBOARDS
+    hangul_init(NULL);
+#endif /* ENABLE_EXTERNAL_KEYBOARDS */
+
+    state_len = hex_decode(lines.lines[0] + 6, state, sizeof(state));
+    hic = hangul_ic_new(NULL);
+    hangul_ic_set_option(hic, HANGUL_IC_OPTION_TRACE, true);
+    if (state_len <= 0 || !hangul_ic_restore_state(hic, state, state_len)) {
+	fprintf(stderr, "%s: cannot restore the state of the trace\n",
+		program_name);
+	hangul_ic_delete(hic);
+	line_list_free(&lines);
+#if ENABLE_EXTERNAL_KEYBOARDS
+	hangul_fini();
+#endif /* ENABLE_EXTERNAL_KEYBOARDS */
+	return EXIT_FAILURE;
+    }
+    hangul_ic_connect_callback(hic, "translate", on_translate, &translated);
+
+    for (i = 1; i < lines.n; i++) {
+	const char* line = lines.lines[i];
+	const char* field = strstr(line, " ch=");
+	unsigned int ch = 0;
+	int key;
+
+	if (field == NULL || sscanf(field, " ch=%x", &ch) != 1) {
+	    fprintf(stderr, "%s: invalid event at line %zu: %s\n",
+		    program_name, i + 1, line);
+	    status = EXIT_FAILURE;
+	    break;
+	}
+
+	if (strncmp(line, "reset ", 6) == 0) {
+	    hangul_ic_reset(hic);
+	} else if (strncmp(line, "flush ", 6) == 0) {
+	    hangul_ic_flush(hic);
+	} else if (sscanf(line, "key=%d", &key) == 1) {
+	    translated = ch;
+	    hangul_ic_process(hic, key);
+	} else {
+	    fprintf(stderr, "%s: invalid event at line %zu: %s\n",
+		    program_name, i + 1, line);
+	    status = EXIT_FAILURE;
+	    break;
+	}
+
+	if (verbose) {
+	    printf("%s", line);
+	    print_ucs4("commit", hangul_ic_get_commit_string(hic));
+	    print_ucs4("preedit", hangul_ic_get_preedit_string(hic));
+	    putchar('\n');
+	}
+    }
+
+    if (status == EXIT_SUCCESS) {
+	dump_len = hangul_ic_dump_trace(hic, NULL, 0);
+	dump = malloc(dump_len + 1);
+	if (dump != NULL) {
+	    char* line;
+
+	    hangul_ic_dump_trace(hic, dump, dump_len + 1);
+	    for (line = strtok(dump, "\n"); line != NULL;
+		 line = strtok(NULL, "\n"))
+		line_list_add(&replayed, line);
+	    free(dump);
+	}
+
+	for (i = 0; i < lines.n || i < replayed.n; i++) {
+	    const char* expected = i < lines.n ? lines.lines[i] : "(none)";
+	    const char* actual = i < replayed.n ? replayed.lines[i] : "(none)";
+
+	    if (strcmp(expected, actual) != 0) {
+		printf("event %zu differs\n  trace:  %s\n  replay: %s\n",
+		       i, expected, actual);
+		status = EXIT_FAILURE;
+		break;
+	    }
+	}
+
+	if (status == EXIT_SUCCESS)
+	    printf("%zu events reproduced\n", lines.n - 1);
+    }
+
+    line_list_free(&replayed);
+    line_list_free(&lines);
+    hangul_ic_delete(hic);
+
+#if ENABLE_EXTERNAL_KEYBOARDS
+    hangul_fini();
+#endif /* ENABLE_EXTERNAL_KEYBOARDS */
+
+    return status;
+}
@@ -0,0 +1,724 @@
+/* libhangul
+ * Copyright (C) 2005 - 2016 Choe Hwanjin
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/* hanja.txt 생성 도구
+ *
+ * data/hanja/merge.py 와 같은 일을 한다. 입력 파일들의 key:value:comment
+ * 엔트리를 모아서 호환 한자를 통합 한자로 바꾸고, 중복된 엔트리를 합친 후
+ * 키 순서로, 같은 키 안에서는 빈도 순서로 정렬하여 출력한다. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <getopt.h>
+#include <errno.h>
+
+typedef uint32_t ucschar;
+
+typedef struct _CompatPair  CompatPair;
+typedef struct _FreqItem    FreqItem;
+typedef struct _Entry       Entry;
+
+struct _CompatPair {
+    ucschar compat;
+    ucschar unified;
+};
+
+struct _FreqItem {
+    char*  key;
+    double freq;
+};
+
+struct _Entry {
+    char*  key;
+    char*  value;
+    char*  comment;
+    double freq;
+    size_t seq;
+    int    removed;
+};
+
+typedef struct {
+    void*  data;
+    size_t len;
+    size_t alloc;
+    size_t size;
+} Array;
+
+static const char* program_name = "hanja-merge";
+
+static CompatPair* compat_table = NULL;
+static size_t      compat_table_size = 0;
+static FreqItem*   freq_table = NULL;
+static size_t      freq_table_size = 0;
+
+static void*
+xmalloc(size_t size)
+{
+    void* p = malloc(size);
+    if (p == NULL) {
+	fprintf(stderr, "%s: %s\n", program_name, strerror(ENOMEM));
+	exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+static char*
+xstrdup(const char* str)
+{
+    size_t n = strlen(str) + 1;
+    char* p = xmalloc(n);
+    memcpy(p, str, n);
+    return p;
+}
+
+static void*
+array_append(Array* array)
+{
+    if (array->len >= array->alloc) {
+	size_t n = array->alloc * 2;
+	void* data;
+
+	if (n == 0)
+	    n = 1024;
+
+	data = realloc(array->data, n * array->size);
+	if (data == NULL) {
+	    fprintf(stderr, "%s: %s\n", program_name, strerror(ENOMEM));
+	    exit(EXIT_FAILURE);
+	}
+
+	array->data = data;
+	array->alloc = n;
+    }
+
+    return (char*)array->data + array->size * array->len++;
+}
+
+/* 앞뒤의 공백 문자를 지운다. python의 str.strip()에 해당한다. */
+static char*
+strip(char* str)
+{
+    char* end;
+
+    while (*str == ' ' || *str == '\t' || *str == '\r' || *str == '\n' ||
+	   *str == '\v' || *str == '\f')
+	str++;
+
+    end = str + strlen(str);
+    while (end > str && (end[-1] == ' ' || end[-1] == '\t' ||
+			 end[-1] == '\r' || end[-1] == '\n' ||
+			 end[-1] == '\v' || end[-1] == '\f'))
+	end--;
+    *end = '\0';
+
+    return str;
+}
+
+static int
+is_unicode_space(ucschar c)
+{
+    return (c >= 0x09 && c <= 0x0d) || (c >= 0x1c && c <= 0x20) ||
+	   c == 0x85 || c == 0xa0 || c == 0x1680 ||
+	   (c >= 0x2000 && c <= 0x200a) || c == 0x2028 || c == 0x2029 ||
+	   c == 0x202f || c == 0x205f || c == 0x3000;
+}
+
+static const char* utf8_decode(const char* p, ucschar* c);
+
+/* 유니코드 공백 문자까지 지운다. python의 unicode.strip()에 해당한다. */
+static char*
+strip_unicode(char* str)
+{
+    char* end = str;
+    char* p = str;
+    int leading = 1;
+
+    while (*p != '\0') {
+	ucschar c;
+	char* next = (char*)utf8_decode(p, &c);
+	if (is_unicode_space(c)) {
+	    if (leading)
+		str = next;
+	} else {
+	    leading = 0;
+	    end = next;
+	}
+	p = next;
+    }
+
+    if (end < str)
+	end = str;
+    *end = '\0';
+
+    return str;
+}
+
+static int
+read_line(FILE* file, char** buf, size_t* bufsize)
+{
+    size_t len = 0;
+
+    if (*buf == NULL) {
+	*bufsize = 1024;
+	*buf = xmalloc(*bufsize);
+    }
+
+    while (fgets(*buf + len, *bufsize - len, file) != NULL) {
+	len += strlen(*buf + len);
+	if (len > 0 && (*buf)[len - 1] == '\n')
+	    return 1;
+
+	*bufsize *= 2;
+	*buf = realloc(*buf, *bufsize);
+	if (*buf == NULL) {
+	    fprintf(stderr, "%s: %s\n", program_name, strerror(ENOMEM));
+	    exit(EXIT_FAILURE);
+	}
+    }
+
+    return len > 0;
+}
+
+static int
+compat_pair_cmp(const void* a, const void* b)
+{
+    const CompatPair* x = a;
+    const CompatPair* y = b;
+
+    if (x->compat < y->compat)
+	return -1;
+    else if (x->compat > y->compat)
+	return 1;
+    return 0;
+}
+
+static void
+load_compat(const char* filename)
+{
+    Array array = { NULL, 0, 0, sizeof(CompatPair) };
+    char* buf = NULL;
+    size_t bufsize = 0;
+    FILE* file;
+
+    file = fopen(filename, "r");
+    if (file == NULL) {
+	fprintf(stderr, "%s: %s: %s\n", program_name, filename, strerror(errno));
+	exit(EXIT_FAILURE);
+    }
+
+    while (read_line(file, &buf, &bufsize)) {
+	char* end;
+	unsigned long compat;
+	unsigned long unified;
+
+	compat = strtoul(buf, &end, 16);
+	if (end == buf)
+	    continue;
+	unified = strtoul(end, NULL, 16);
+
+	CompatPair* pair = array_append(&array);
+	pair->compat = compat;
+	pair->unified = unified;
+    }
+
+    free(buf);
+    fclose(file);
+
+    compat_table = array.data;
+    compat_table_size = array.len;
+    qsort(compat_table, compat_table_size, sizeof(compat_table[0]),
+	  compat_pair_cmp);
+}
+
+static int
+freq_item_cmp(const void* a, const void* b)
+{
+    const FreqItem* x = a;
+    const FreqItem* y = b;
+
+    return strcmp(x->key, y->key);
+}
+
+static void
+load_frequency(Array* array, const char* filename)
+{
+    char* buf = NULL;
+    size_t bufsize = 0;
+    FILE* file;
+
+    file = fopen(filename, "r");
+    if (file == NULL) {
+	fprintf(stderr, "%s: %s: %s\n", program_name, filename, strerror(errno));
+	exit(EXIT_FAILURE);
+    }
+
+    while (read_line(file, &buf, &bufsize)) {
+	char* line = strip(buf);
+	char* sep = strchr(line, ':');
+	if (sep == NULL)
+	    continue;
+
+	*sep = '\0';
+
+	FreqItem* item = array_append(array);
+	item->key = xstrdup(line);
+	item->freq = strtod(sep + 1, NULL);
+    }
+
+    free(buf);
+    fclose(file);
+}
+
+/* 같은 키가 여러번 나오면 가장 큰 값을 사용한다. */
+static void
+build_frequency(Array* array)
+{
+    FreqItem* items = array->data;
+    size_t i, n;
+
+    qsort(items, array->len, sizeof(items[0]), freq_item_cmp);
+
+    n = 0;
+    for (i = 0; i < array->len; i++) {
+	if (n > 0 && strcmp(items[n - 1].key, items[i].key) == 0) {
+	    if (items[i].freq > items[n - 1].freq)
+		items[n - 1].freq = items[i].freq;
+	    free(items[i].key);
+	} else {
+	    items[n++] = items[i];
+	}
+    }
+
+    freq_table = items;
+    freq_table_size = n;
+}
+
+static double
+get_frequency(const char* key)
+{
+    FreqItem item;
+    FreqItem* res;
+
+    item.key = (char*)key;
+    res = bsearch(&item, freq_table, freq_table_size, sizeof(freq_table[0]),
+		  freq_item_cmp);
+    if (res != NULL)
+	return res->freq;
+    return 0;
+}
+
+static const char*
+utf8_decode(const char* p, ucschar* c)
+{
+    const unsigned char* s = (const unsigned char*)p;
+
+    if (s[0] < 0x80) {
+	*c = s[0];
+	return p + 1;
+    } else if ((s[0] & 0xe0) == 0xc0 && s[1] != 0) {
+	*c = ((s[0] & 0x1f) << 6) | (s[1] & 0x3f);
+	return p + 2;
+    } else if ((s[0] & 0xf0) == 0xe0 && s[1] != 0 && s[2] != 0) {
+	*c = ((s[0] & 0x0f) << 12) | ((s[1] & 0x3f) << 6) | (s[2] & 0x3f);
+	return p + 3;
+    } else if ((s[0] & 0xf8) == 0xf0 && s[1] != 0 && s[2] != 0 && s[3] != 0) {
+	*c = ((s[0] & 0x07) << 18) | ((s[1] & 0x3f) << 12) |
+	     ((s[2] & 0x3f) << 6) | (s[3] & 0x3f);
+	return p + 4;
+    }
+
+    *c = s[0];
+    return p + 1;
+}
+
+static char*
+utf8_encode(char* p, ucschar c)
+{
+    if (c < 0x80) {
+	*p++ = c;
+    } else if (c < 0x800) {
+	*p++ = 0xc0 | (c >> 6);
+	*p++ = 0x80 | (c & 0x3f);
+    } else if (c < 0x10000) {
+	*p++ = 0xe0 | (c >> 12);
+	*p++ = 0x80 | ((c >> 6) & 0x3f);
+	*p++ = 0x80 | (c & 0x3f);
+    } else {
+	*p++ = 0xf0 | (c >> 18);
+	*p++ = 0x80 | ((c >> 12) & 0x3f);
+	*p++ = 0x80 | ((c >> 6) & 0x3f);
+	*p++ = 0x80 | (c & 0x3f);
+    }
+    return p;
+}
+
+/* 호환 한자를 통합 한자로 바꾼다. 통합 한자는 모두 BMP에 있으므로
+ * 결과 스트링의 길이는 원래 스트링보다 길어지지 않는다. */
+static char*
+get_unified(const char* text)
+{
+    char* res = xmalloc(strlen(text) * 2 + 1);
+    char* q = res;
+    const char* p = text;
+
+    while (*p != '\0') {
+	const char* next;
+	CompatPair key;
+	CompatPair* pair;
+
+	next = utf8_decode(p, &key.compat);
+	pair = bsearch(&key, compat_table, compat_table_size,
+		       sizeof(compat_table[0]), compat_pair_cmp);
+	if (pair != NULL) {
+	    q = utf8_encode(q, pair->unified);
+	} else {
+	    memcpy(q, p, next - p);
+	    q += next - p;
+	}
+	p = next;
+    }
+    *q = '\0';
+
+    return res;
+}
+
+static char*
+remove_spaces(const char* str)
+{
+    char* res = xmalloc(strlen(str) + 1);
+    char* q = res;
+
+    for (; *str != '\0'; str++) {
+	if (*str != ' ')
+	    *q++ = *str;
+    }
+    *q = '\0';
+
+    return res;
+}
+
+static int
+entry_key_cmp(const void* a, const void* b)
+{
+    const Entry* x = a;
+    const Entry* y = b;
+    int res = strcmp(x->key, y->key);
+
+    if (res != 0)
+	return res;
+
+    if (x->seq < y->seq)
+	return -1;
+    else if (x->seq > y->seq)
+	return 1;
+    return 0;
+}
+
+/* 같은 키 안에서는 빈도가 높은 것이 먼저 나오게 하고, 빈도가 같으면
+ * 입력된 순서를 유지한다. */
+static int
+entry_freq_cmp(const void* a, const void* b)
+{
+    const Entry* x = a;
+    const Entry* y = b;
+
+    if (x->freq > y->freq)
+	return -1;
+    else if (x->freq < y->freq)
+	return 1;
+
+    if (x->seq < y->seq)
+	return -1;
+    else if (x->seq > y->seq)
+	return 1;
+    return 0;
+}
+
+static void
+load_entries(Array* entries, Array* header, const char* filename)
+{
+    char* buf = NULL;
+    size_t bufsize = 0;
+    FILE* file;
+
+    file = fopen(filename, "r");
+    if (file == NULL) {
+	fprintf(stderr, "%s: %s: %s\n", program_name, filename, strerror(errno));
+	exit(EXIT_FAILURE);
+    }
+
+    while (read_line(file, &buf, &bufsize)) {
+	char* fields[3];
+	char* line;
+	char* p;
+	int n;
+
+	if (buf[0] == '#') {
+	    char** h = array_append(header);
+	    *h = xstrdup(buf);
+	    continue;
+	}
+
+	line = strip(buf);
+	n = 0;
+	p = line;
+	while (n < 3) {
+	    fields[n++] = p;
+	    p = strchr(p, ':');
+	    if (p == NULL)
+		break;
+	    *p++ = '\0';
+	}
+
+	if (n < 3)
+	    continue;
+
+	/* python 구현과 같이 네번째 필드 이후는 버린다. */
+	p = strchr(fields[2], ':');
+	if (p != NULL)
+	    *p = '\0';
+
+	Entry* entry = array_append(entries);
+	entry->key = xstrdup(fields[0]);
+	entry->value = get_unified(fields[1]);
+	entry->comment = xstrdup(strip_unicode(fields[2]));
+	entry->freq = get_frequency(entry->value);
+	entry->seq = entries->len - 1;
+	entry->removed = 0;
+    }
+
+    free(buf);
+    fclose(file);
+}
+
+static void
+merge_comment(Entry* prev, Entry* entry)
+{
+    const char* key = entry->key;
+    const char* value = entry->value;
+
+    if (entry->comment[0] == '\0') {
+	fprintf(stderr, "%s:%s is duplicate, ignored\n", key, value);
+    } else if (prev->comment[0] == '\0') {
+	fprintf(stderr, "%s:%s is duplicate, but has new comment, added: ",
+		key, value);
+	fprintf(stderr, "\"%s\"\n", entry->comment);
+	free(prev->comment);
+	prev->comment = entry->comment;
+	entry->comment = NULL;
+    } else if (strcmp(prev->comment, entry->comment) == 0) {
+	fprintf(stderr, "%s:%s is duplicate, ignored\n", key, value);
+    } else {
+	/* 기존의 테이블에 새로운 커멘트가 있는지 확인한다.
+	 * 띠어쓰기로 다른 스트링으로 처리되는 문제를 피하기
+	 * 위해서 빈칸을 지운다 */
+	char* haystack = remove_spaces(prev->comment);
+	char* needle = remove_spaces(entry->comment);
+
+	if (strstr(haystack, needle) != NULL) {
+	    fprintf(stderr, "%s:%s is duplicate, already includes that comments, ignored\n",
+		    key, value);
+	} else {
+	    size_t len = strlen(prev->comment) + strlen(entry->comment) + 3;
+	    char* comment = xmalloc(len);
+
+	    fprintf(stderr, "%s:%s is duplicate, but has different comments, merged: ",
+		    key, value);
+	    fprintf(stderr, "\"%s\" + \"%s\"\n", prev->comment, entry->comment);
+
+	    snprintf(comment, len, "%s, %s", prev->comment, entry->comment);
+	    free(prev->comment);
+	    prev->comment = comment;
+	}
+
+	free(haystack);
+	free(needle);
+    }
+
+    entry->removed = 1;
+}
+
+/* 한 키에 해당하는 엔트리들 중에서 값이 같은 것을 합친다.
+ * entries는 입력된 순서로 정렬되어 있어야 한다. */
+static void
+merge_duplicates(Entry* entries, size_t n)
+{
+    size_t i, j;
+
+    for (i = 1; i < n; i++) {
+	for (j = 0; j < i; j++) {
+	    if (entries[j].removed)
+		continue;
+
+	    if (strcmp(entries[j].value, entries[i].value) == 0) {
+		merge_comment(&entries[j], &entries[i]);
+		break;
+	    }
+	}
+    }
+}
+
+static void
+usage(int status)
+{
+    if (status == EXIT_SUCCESS) {
+	printf("\
+Usage: %s [OPTION]... FILE...\n\
+\n\
+Merge hanja dictionary source FILEs into a single sorted hanja.txt.\n\
+\n\
+  -f, --frequency=FILE   load frequency table from FILE, may be given\n\
+                         more than once (default: freq-hanja.txt and\n\
+                         freq-hanjaeo.txt)\n\
+  -c, --compat=FILE      load compatibility hanja table from FILE\n\
+                         (default: compat-table.txt)\n\
+  -o, --output=FILE      write result to FILE instead of standard output\n\
+      --help             display this help and exit\n\
+", program_name);
+    } else {
+	fprintf(stderr, "Try `%s --help' for more information.\n",
+		program_name);
+    }
+
+    exit(status);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char* default_freq_files[] = { "freq-hanja.txt", "freq-hanjaeo.txt" };
+    const char* compat_file = "compat-table.txt";
+    const char* output_file = "-";
+    Array freq_files = { NULL, 0, 0, sizeof(char*) };
+    Array freq = { NULL, 0, 0, sizeof(FreqItem) };
+    Array entries = { NULL, 0, 0, sizeof(Entry) };
+    Array header = { NULL, 0, 0, sizeof(char*) };
+    FILE* output;
+    Entry* items;
+    size_t i, j;
+
+    while (1) {
+	int c;
+	static struct option const long_options[] = {
+	    { "frequency",   required_argument,  NULL, 'f' },
+	    { "compat",      required_argument,  NULL, 'c' },
+	    { "output",      required_argument,  NULL, 'o' },
+	    { "help",        no_argument,        NULL, 'h' },
+	    { NULL,          0,                  NULL, 0   }
+	};
+
+	c = getopt_long(argc, argv, "f:c:o:", long_options, NULL);
+	if (c == -1)
+	    break;
+
+	switch (c) {
+	case 'f':
+	    *(char**)array_append(&freq_files) = optarg;
+	    break;
+	case 'c':
+	    compat_file = optarg;
+	    break;
+	case 'o':
+	    output_file = optarg;
+	    break;
+	case 'h':
+	    usage(EXIT_SUCCESS);
+	    break;
+	default:
+	    usage(EXIT_FAILURE);
+	}
+    }
+
+    if (optind >= argc)
+	usage(EXIT_FAILURE);
+
+    if (freq_files.len == 0) {
+	for (i = 0; i < sizeof(default_freq_files) / sizeof(default_freq_files[0]); i++)
+	    *(const char**)array_append(&freq_files) = default_freq_files[i];
+    }
+
+    for (i = 0; i < freq_files.len; i++)
+	load_frequency(&freq, ((char**)freq_files.data)[i]);
+    build_frequency(&freq);
+
+    load_compat(compat_file);
+
+    for (i = optind; i < argc; i++)
+	load_entries(&entries, &header, argv[i]);
+
+    items = entries.data;
+    qsort(items, entries.len, sizeof(items[0]), entry_key_cmp);
+
+    if (strcmp(output_file, "-") == 0) {
+	output = stdout;
+    } else {
+	output = fopen(output_file, "w");
+	if (output == NULL) {
+	    fprintf(stderr, "%s: %s: %s\n", program_name, output_file,
+		    strerror(errno));
+	    exit(EXIT_FAILURE);
+	}
+    }
+
+    for (i = 0; i < header.len; i++)
+	fputs(((char**)header.data)[i], output);
+    fputc('\n', output);
+
+    for (i = 0; i < entries.len; i = j) {
+	size_t k;
+
+	for (j = i + 1; j < entries.len; j++) {
+	    if (strcmp(items[i].key, items[j].key) != 0)
+		break;
+	}
+
+	merge_duplicates(items + i, j - i);
+	qsort(items + i, j - i, sizeof(items[0]), entry_freq_cmp);
+
+	for (k = i; k < j; k++) {
+	    if (items[k].removed)
+		continue;
+	    fprintf(output, "%s:%s:%s\n",
+		    items[k].key, items[k].value, items[k].comment);
+	}
+    }
+
+    if (output != stdout)
+	fclose(output);
+
+    for (i = 0; i < entries.len; i++) {
+	free(items[i].key);
+	free(items[i].value);
+	free(items[i].comment);
+    }
+    free(items);
+
+    for (i = 0; i < header.len; i++)
+	free(((char**)header.data)[i]);
+    free(header.data);
+
+    for (i = 0; i < freq_table_size; i++)
+	free(freq_table[i].key);
+    free(freq_table);
+    free(compat_table);
+    free(freq_files.data);
+
+    return EXIT_SUCCESS;
+}